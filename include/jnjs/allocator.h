@@ -0,0 +1,138 @@
+#pragma once
+/**
+ * @file allocator.h
+ * @brief Custom memory allocators for runtimes.
+ */
+
+#include <array>
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief Interface for the allocator a runtime uses for all of its memory.
+ *
+ * An allocator is owned by exactly one runtime and is only ever called from the thread using that runtime, so
+ * implementations do not need to be thread-safe. Every block handed out must be aligned to at least 16 bytes.
+ */
+class allocator {
+  public:
+    virtual ~allocator() = default;
+
+    /**
+     * @brief Allocate a block of memory.
+     * @param size Size of the block in bytes, never 0.
+     * @return The new block, or nullptr if out of memory.
+     */
+    virtual void *allocate(size_t size) = 0;
+    /**
+     * @brief Release a block of memory.
+     * @param p Block returned by allocate or reallocate.
+     * @param size Size the block was allocated with.
+     */
+    virtual void deallocate(void *p, size_t size) noexcept = 0;
+    /**
+     * @brief Resize a block of memory, preserving its contents.
+     * @note The default implementation allocates a new block and copies into it.
+     * @param p Block returned by allocate or reallocate.
+     * @param old_size Size the block was allocated with.
+     * @param new_size New size of the block in bytes, never 0.
+     * @return The resized block, or nullptr if out of memory, in which case `p` is left untouched.
+     */
+    virtual void *reallocate(void *p, size_t old_size, size_t new_size);
+};
+
+/**
+ * @brief Allocator serving small blocks from per size-class free lists.
+ *
+ * Blocks up to max_pooled_size are rounded up to a multiple of granularity and carved out of large chunks; freed
+ * blocks go back onto their size class' free list and are reused without touching the system allocator. Larger
+ * blocks go straight to malloc. Chunks are only returned to the system when the allocator is destroyed.
+ */
+class pool_allocator final : public allocator {
+  public:
+    constexpr static size_t granularity = 16;
+    constexpr static size_t max_pooled_size = 512;
+
+    /**
+     * @brief Create a pool allocator.
+     * @param chunk_size Size of the chunks small blocks are carved from.
+     */
+    explicit pool_allocator(size_t chunk_size = 64 * 1024);
+    ~pool_allocator() override;
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(pool_allocator)
+
+    void *allocate(size_t size) override;
+    void deallocate(void *p, size_t size) noexcept override;
+    void *reallocate(void *p, size_t old_size, size_t new_size) override;
+
+  private:
+    struct free_block {
+        free_block *next;
+    };
+    constexpr static size_t class_count = max_pooled_size / granularity;
+    constexpr static size_t class_of(size_t size) { return (size + granularity - 1) / granularity - 1; }
+
+    std::array<free_block *, class_count> _free = {};
+    std::vector<void *> _chunks;
+    size_t _chunk_size;
+    char *_cur = nullptr;
+    char *_end = nullptr;
+};
+
+/**
+ * @brief Bump allocator that only releases memory when it is destroyed.
+ *
+ * Allocation is a pointer increment, and freeing is a no-op unless the block was the most recent allocation. This is
+ * the fastest option for runtimes that run a short script and are then thrown away, but memory held by a long lived
+ * runtime only ever grows.
+ */
+class arena_allocator final : public allocator {
+  public:
+    /**
+     * @brief Create an arena.
+     * @param block_size Size of the blocks the arena bumps through, larger allocations get a block of their own.
+     */
+    explicit arena_allocator(size_t block_size = 1024 * 1024);
+    ~arena_allocator() override;
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(arena_allocator)
+
+    void *allocate(size_t size) override;
+    void deallocate(void *p, size_t size) noexcept override;
+    void *reallocate(void *p, size_t old_size, size_t new_size) override;
+
+    /**
+     * @brief Get the amount of memory reserved from the system.
+     * @return Bytes held by the arena, including unused space at the end of each block.
+     */
+    [[nodiscard]] size_t reserved() const { return _reserved; }
+
+  private:
+    constexpr static size_t round(size_t size) { return (size + 15) & ~size_t(15); }
+
+    std::vector<void *> _blocks;
+    std::unordered_set<void *> _large;
+    size_t _block_size;
+    size_t _reserved = 0;
+    char *_cur = nullptr;
+    char *_end = nullptr;
+};
+
+namespace detail {
+/**
+ * @internal
+ * @brief QuickJS malloc functions forwarding to a jnjs::allocator passed as the opaque.
+ * @return Malloc functions for JS_NewRuntime2.
+ */
+const JSMallocFunctions &allocator_malloc_functions();
+} // namespace detail
+
+} // namespace jnjs
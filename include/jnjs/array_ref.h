@@ -0,0 +1,124 @@
+#pragma once
+/**
+ * @file array_ref.h
+ * @brief C++ containers exposed to JavaScript by reference.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <quickjs.h>
+
+#include "binding.h"
+
+#include "detail/fwd.h"
+#include "detail/hedley.h"
+#include "detail/runtime_data.h"
+#include "detail/value_helpers.h"
+
+namespace jnjs {
+
+/**
+ * @brief A C++ container shown to JavaScript as an array-like object, without copying its elements.
+ *
+ * Reading an element or the length from JS goes straight to the container, and assigning to an element writes
+ * through, unless the container is const. The object inherits from Array.prototype, so array methods, spreading and
+ * `for...of` work, but it is not an array to `Array.isArray`, and can not grow or shrink from JS. The class is
+ * installed in a context the first time an array_ref is converted there.
+ * @tparam C Container with `size()` and `operator[]`, e.g. `std::vector<T>`, `std::deque<T>` or `std::span<T>`.
+ *
+ * @code
+ * static std::vector<double> samples = load();
+ * jnjs::array_ref<std::vector<double>> get_samples() { return jnjs::array_ref(samples); }
+ * @endcode
+ */
+template <typename C> class array_ref {
+  public:
+    using element_type = std::remove_cvref_t<decltype(std::declval<C &>()[0])>;
+    constexpr static bool writable = requires(C &c, element_type v) { c[0] = std::move(v); };
+
+    /**
+     * @brief Refer to a container without owning it.
+     * @param c Container, must outlive every JS object created from this array_ref.
+     */
+    explicit array_ref(C &c) : _c(std::shared_ptr<C>(), &c) {}
+    /**
+     * @brief Refer to a shared container, which JS objects created from this array_ref keep alive.
+     * @param c Container.
+     */
+    explicit array_ref(std::shared_ptr<C> c) : _c(std::move(c)) {}
+
+    [[nodiscard]] size_t size() const { return std::size(*_c); }
+    [[nodiscard]] element_type get(size_t i) const { return (*_c)[i]; }
+    void set(size_t i, element_type v)
+        requires writable
+    {
+        (*_c)[i] = std::move(v);
+    }
+
+    /**
+     * @brief Get the referenced container.
+     * @return The container.
+     */
+    [[nodiscard]] C &container() const { return *_c; }
+
+    constexpr static wrapped_class_builder<array_ref> build_js_class() {
+        wrapped_class_builder<array_ref> b("ArrayRef");
+        if constexpr (writable) {
+            b.template bind_indexer<&array_ref::size, &array_ref::get, &array_ref::set>();
+        } else {
+            b.template bind_indexer<&array_ref::size, &array_ref::get>();
+        }
+        b._bind_dtor();
+        return b;
+    }
+
+  private:
+    /**
+     * @internal
+     * @brief Install the class in a context.
+     * @note Every instantiation shares the class name, so nothing is defined on the global object.
+     * @return The class ID.
+     */
+    static JSClassID _install(JSContext *ctx) {
+        const auto b = build_js_class();
+        detail::declare_class(ctx, b._d, detail::internal_class_meta<array_ref>::data, JS_UNDEFINED);
+        return detail::class_id<array_ref>(ctx);
+    }
+
+    std::shared_ptr<C> _c;
+    friend detail::value_helpers<array_ref>;
+};
+
+template <typename C> array_ref(C &) -> array_ref<C>;
+template <typename C> array_ref(std::shared_ptr<C>) -> array_ref<C>;
+
+/**
+ * @note Converting to JS creates a new object referring to the same container, and installs the class in the context
+ * if needed.
+ */
+template <typename C> struct detail::value_helpers<array_ref<C>> {
+    static bool is(JSContext *c, JSValue v) {
+        const auto id = class_id<array_ref<C>>(c);
+        return id != 0 && JS_GetClassID(v) == id;
+    }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static array_ref<C> as(JSContext *c, JSValue v) { return *value_helpers<array_ref<C> *>::as(c, v); }
+    static JSValue from(JSContext *c, const array_ref<C> &v) {
+        auto id = class_id<array_ref<C>>(c);
+        auto proto = id != 0 ? JS_GetClassProto(c, id) : JS_NULL;
+        if (HEDLEY_UNLIKELY(!JS_IsObject(proto)))
+            id = array_ref<C>::_install(c);
+        JS_FreeValue(c, proto);
+        auto ret = JS_NewObjectClass(c, id);
+        if (HEDLEY_UNLIKELY(JS_IsException(ret)))
+            return ret;
+        JS_SetOpaque(ret, new array_ref<C>(v));
+        return ret;
+    }
+};
+
+} // namespace jnjs
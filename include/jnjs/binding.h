@@ -2,6 +2,7 @@
 
 #include "detail/function_helpers.h"
 #include "detail/fwd.h"
+#include "detail/indexer.h"
 #include "detail/util.h"
 
 #include <array>
@@ -17,8 +18,20 @@ struct class_builder_data {
     JSClassDef def = {};
     JSCFunction *ctor = nullptr;
     int ctor_len = 0;
+    bool array_like = false;
 };
 
+/**
+ * @internal
+ * @brief Install a class in a context, registering it with the runtime first if needed.
+ * @param ctx JS context.
+ * @param d Class definition.
+ * @param o Class metadata.
+ * @param global Object the constructor, if any, is defined on, or undefined to register the class and prototype only.
+ */
+void declare_class(JSContext *ctx, const class_builder_data &d, const internal_class_meta_data &o,
+                   JSValueConst global);
+
 } // namespace detail
 
 /**
@@ -107,6 +120,26 @@ template <typename Klass> struct wrapped_class_builder {
         _d.ctor = binder::call;
     }
 
+    /**
+     * @brief make instances array-like, with indexed elements and a length forwarding to the C++ object
+     * @note the prototype inherits from Array.prototype, so array methods and iteration work on instances, but elements
+     * can not be added or removed from JS
+     * @tparam Size function returning the number of elements
+     * @tparam Get function returning the element at an index
+     * @tparam Set function storing an element at an index, or nullptr for read only elements
+     */
+    template <auto Size, auto Get, auto Set = nullptr> constexpr void bind_indexer() {
+        using helper = detail::indexer<Klass, Size, Get, Set>;
+        _d.def.exotic = &helper::methods;
+        _d.array_like = true;
+        auto &fn = _next_entry("length");
+        fn.prop_flags = JS_PROP_CONFIGURABLE;
+        fn.def_type = JS_DEF_CGETSET;
+        fn.u.getset = {};
+        fn.u.getset.get.getter = helper::length;
+        fn.u.getset.set.setter = nullptr;
+    }
+
   private:
     constexpr void _bind_dtor() {
         if (_d.def.finalizer)
@@ -126,8 +159,8 @@ template <typename Klass> struct wrapped_class_builder {
         static Klass *call(Args &&...args) { return new Klass(std::forward<Args &&>(args)...); }
     };
     struct dtor_helper {
-        static void call(JSRuntime *, JSValue v) {
-            auto *t = detail::arg_list_helpers::get_class<Klass>(v);
+        static void call(JSRuntime *rt, JSValue v) {
+            auto *t = detail::arg_list_helpers::get_class<Klass>(rt, v);
             delete t;
         }
     };
@@ -136,7 +169,9 @@ template <typename Klass> struct wrapped_class_builder {
     detail::class_builder_data _d = {};
     friend runtime;
     friend context;
+    friend context_template;
     friend module;
+    template <typename> friend class array_ref;
 };
 
 } // namespace jnjs
@@ -0,0 +1,179 @@
+#pragma once
+/**
+ * @file borrowed_value.h
+ * @brief Non-owning view of a JavaScript value.
+ */
+
+#include <quickjs.h>
+
+#include "value.h"
+
+#include "detail/fwd.h"
+#include "detail/hedley.h"
+#include "detail/runtime_data.h"
+#include "detail/value_helpers.h"
+
+namespace jnjs {
+
+/**
+ * @brief A JavaScript value used without holding a reference to it.
+ *
+ * Creating, copying and destroying a borrowed_value never touches the value's reference count, which makes it the
+ * cheapest way to inspect a value. It is only valid as long as the value or call it was borrowed from: a borrow of a
+ * jnjs::value must not outlive that value, and a bound function's borrowed_value arguments must not outlive the call.
+ * With the JNJS_DEBUG_BORROWS CMake option, on by default in Debug builds, breaking either rule aborts when the owner
+ * goes away. Use to_value() to keep the value around.
+ *
+ * @code
+ * int count(jnjs::borrowed_value v) { return v.is<jnjs::function>() ? 1 : 0; }
+ * @endcode
+ */
+class borrowed_value {
+  public:
+    // Create a borrow of `undefined`.
+    borrowed_value() = default;
+    /**
+     * @brief Borrow a value.
+     * @param v Value to borrow, must outlive the borrow.
+     */
+    borrowed_value(const value &v) noexcept : borrowed_value(v._v, v._ctx, &v) {} // NOLINT(google-explicit-constructor)
+    ~borrowed_value() { detail::track_borrow(_ctx, _owner, -1); }
+
+    borrowed_value(const borrowed_value &o) noexcept : borrowed_value(o._v, o._ctx, o._owner) {}
+    borrowed_value &operator=(const borrowed_value &o) noexcept {
+        if (this != &o) {
+            detail::track_borrow(o._ctx, o._owner, 1);
+            detail::track_borrow(_ctx, _owner, -1);
+            _v = o._v;
+            _ctx = o._ctx;
+            _owner = o._owner;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Take a reference to the value.
+     * @return An owning value, which may outlive the borrow.
+     */
+    [[nodiscard]] value to_value() const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return value(JS_DupValue(_ctx, _v), _ctx);
+    }
+
+    /**
+     * @brief Get a property of the value by name.
+     * @param name Name of the property to access.
+     * @return The value of the property, or undefined if the property does not exist.
+     */
+    value operator[](const char *name) const noexcept {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return value(JS_GetPropertyStr(_ctx, _v, name), _ctx);
+    }
+
+    /**
+     * @brief Get a property of the value by index.
+     * @param idx Index of the property to access.
+     * @return The value of the property at the specified index, or undefined if the index is out of bounds.
+     */
+    value operator[](const int idx) const noexcept {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return value(JS_GetPropertyInt64(_ctx, _v, idx), _ctx);
+    }
+
+    /**
+     * @brief Get a property of the value by a cached key.
+     * @param key Key of the property to access.
+     * @return The value of the property, or undefined if the property does not exist.
+     */
+    value operator[](const prop_key &key) const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return value(JS_GetProperty(_ctx, _v, key.atom(_ctx)), _ctx);
+    }
+
+    /**
+     * @brief Strictly compare this value to another value.
+     * @tparam T Type to compare to
+     * @param rhs Value to compare against.
+     * @return If the values are both of the same type and equal.
+     */
+    template <typename T> bool operator==(const T &rhs) const {
+        return detail::value_helpers<T>::is(_ctx, _v) && detail::value_helpers<T>::as(_ctx, _v) == rhs;
+    }
+
+    /**
+     * @brief Loosely compare this value to another value.
+     * @tparam T Type to compare to
+     * @param rhs Value to compare against.
+     * @return If the values are convertible to the same type and equal.
+     */
+    template <typename T> bool kinda_eq(const T &rhs) const {
+        return detail::value_helpers<T>::is_convertible(_ctx, _v) && detail::value_helpers<T>::as(_ctx, _v) == rhs;
+    }
+
+    /**
+     * @brief Check if the value is of a specific type.
+     * @tparam T Type to check against.
+     * @return If the value is of type T.
+     */
+    template <typename T> [[nodiscard]] bool is() const { return detail::value_helpers<T>::is(_ctx, _v); }
+    /**
+     * @brief Check if the value is convertible to a specific type.
+     * @tparam T Type to check against.
+     * @return If the value is convertible to type T.
+     */
+    template <typename T> [[nodiscard]] bool is_convertible() const {
+        return detail::value_helpers<T>::is_convertible(_ctx, _v);
+    }
+    /**
+     * @brief Convert the value to a specific type.
+     * @tparam T Type to convert to.
+     * @return The value converted to type T.
+     */
+    template <typename T> T as() const { return detail::value_helpers<T>::as(_ctx, _v); }
+
+  private:
+    /**
+     * @internal Borrow a JSValue.
+     * @param v JSValue to borrow.
+     * @param ctx JavaScript context in which the value exists.
+     * @param owner Value or argument list the borrow is checked against, or nullptr.
+     */
+    borrowed_value(JSValue v, JSContext *ctx, const void *owner) noexcept : _v(v), _ctx(ctx), _owner(owner) {
+        detail::track_borrow(_ctx, _owner, 1);
+    }
+
+    JSValue _v = JS_UNDEFINED;    /**< @internal The borrowed JSValue. */
+    JSContext *_ctx = nullptr;    /**< @internal The JavaScript context in which the value exists. */
+    const void *_owner = nullptr; /**< @internal What the value is borrowed from, for JNJS_DEBUG_BORROWS. */
+    friend value_scope;
+    friend detail::value_helpers<borrowed_value>;
+};
+
+/**
+ * @note Converting to a JSValue takes a new reference, e.g. when a bound function returns a borrowed_value.
+ */
+template <> struct detail::value_helpers<borrowed_value> {
+    static bool is(JSContext *, JSValue) { return true; }
+    static bool is_convertible(JSContext *, JSValue) { return true; }
+    static JSValue from(JSContext *c, const borrowed_value &v) { return JS_DupValue(c, v._v); }
+
+    /**
+     * @internal
+     * @brief Borrow a JSValue.
+     * @param c JS context.
+     * @param v JSValue to borrow.
+     * @param owner Value or argument list the borrow is checked against, or nullptr.
+     * @return The borrow.
+     */
+    static borrowed_value borrow(JSContext *c, JSValue v, const void *owner) { return {v, c, owner}; }
+};
+
+} // namespace jnjs
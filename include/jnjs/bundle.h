@@ -0,0 +1,136 @@
+#pragma once
+/**
+ * @file bundle.h
+ * @brief Files of precompiled scripts and modules.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "context.h"
+#include "value.h"
+
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief Read-only, memory mapped file of precompiled scripts and modules.
+ *
+ * Opening a bundle maps the file and checks its header, nothing is deserialized until an entry is used. Once a
+ * bundle is attached to a runtime with runtime::set_bundle, `import` statements in that runtime load modules from it,
+ * each the first time it is imported. Bundles are written by bundle_writer, or by `jnjs_cli bundle`.
+ *
+ * A bundle is immutable, so one instance can be shared by the runtimes of any number of threads.
+ * @warning Bytecode is trusted input to QuickJS: only load bundles from trusted sources.
+ */
+class bundle {
+  public:
+    /**
+     * @brief What an entry was compiled as.
+     */
+    enum class kind : uint32_t { script, module };
+
+    /**
+     * @brief Open a bundle file.
+     * @param path Path of the bundle.
+     * @throws std::runtime_error if the file can not be read, is not a bundle, or was written for a different QuickJS
+     * version.
+     */
+    explicit bundle(const std::filesystem::path &path);
+    ~bundle();
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(bundle)
+
+    /**
+     * @brief Run an entry.
+     * @param ctx Context to run the entry in.
+     * @param name Name of the entry.
+     * @return Completion value for scripts, a promise for modules, or an exception if the entry does not exist.
+     */
+    value run(context &ctx, std::string_view name) const;
+
+    /**
+     * @brief Check if the bundle holds an entry.
+     * @param name Name of the entry.
+     * @return If the entry exists.
+     */
+    [[nodiscard]] bool contains(std::string_view name) const { return _find(name) != nullptr; }
+
+    /**
+     * @brief Get the number of entries.
+     * @return Number of scripts and modules in the bundle.
+     */
+    [[nodiscard]] size_t size() const { return _count; }
+
+  private:
+    struct mapping;
+    struct index_entry;
+
+    [[nodiscard]] const index_entry *_find(std::string_view name) const;
+    JSValue _read(JSContext *ctx, const index_entry &e) const;
+    static JSModuleDef *_load_module(JSContext *ctx, const char *name, void *opaque);
+
+    std::unique_ptr<mapping> _map;
+    const index_entry *_index = nullptr;
+    size_t _count = 0;
+    friend runtime;
+    friend bundle_writer;
+};
+
+/**
+ * @brief Compiles scripts and modules into a bundle file.
+ */
+class bundle_writer {
+  public:
+    /**
+     * @brief Create a writer.
+     * @param ctx Context to compile entries with.
+     */
+    explicit bundle_writer(context &ctx) : _ctx(ctx) {}
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(bundle_writer)
+
+    /**
+     * @brief Compile a script into the bundle.
+     * @param name Name of the entry, also used as its filename in stack traces.
+     * @param source Code of the script.
+     * @throws js_error if the script fails to parse.
+     */
+    void add_script(std::string name, std::string_view source) { _add(std::move(name), source, bundle::kind::script); }
+
+    /**
+     * @brief Compile an ES module into the bundle.
+     * @param name Name the module is imported by, relative imports inside it are resolved against it.
+     * @param source Code of the module.
+     * @throws js_error if the module fails to parse.
+     */
+    void add_module(std::string name, std::string_view source) { _add(std::move(name), source, bundle::kind::module); }
+
+    /**
+     * @brief Write the bundle to a file, replacing it if it exists.
+     * @param path Path to write to.
+     * @return If the file was written.
+     */
+    [[nodiscard]] bool write(const std::filesystem::path &path) const;
+
+  private:
+    struct entry {
+        std::string name;
+        bundle::kind kind;
+        std::vector<uint8_t> bytecode;
+    };
+
+    void _add(std::string name, std::string_view source, bundle::kind k);
+
+    context &_ctx;
+    std::vector<entry> _entries;
+};
+
+} // namespace jnjs
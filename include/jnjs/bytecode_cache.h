@@ -0,0 +1,81 @@
+#pragma once
+/**
+ * @file bytecode_cache.h
+ * @brief On-disk cache of compiled scripts.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "context.h"
+#include "script.h"
+#include "value.h"
+
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief Stores the bytecode of compiled scripts in a directory, so they are only parsed once across restarts.
+ *
+ * Entries are keyed by a hash of the script's source and filename. Each file also stores the full source and filename,
+ * so a hash collision is a miss rather than the wrong script, and is stamped with the QuickJS version that wrote it;
+ * entries from any other version, or that are damaged, are treated as misses and overwritten. Files
+ * are written to a temporary name and renamed into place, so any number of threads and processes can share one
+ * directory. Failing to read or write the cache never fails the compilation itself.
+ *
+ * @warning Bytecode is trusted input to QuickJS: only point the cache at a directory nobody else can write to.
+ */
+class bytecode_cache {
+  public:
+    /**
+     * @brief Open a cache directory, creating it if needed.
+     * @param dir Directory to keep cache entries in.
+     */
+    explicit bytecode_cache(std::filesystem::path dir);
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(bytecode_cache)
+
+    /**
+     * @brief Load a script from the cache, or compile it and store the result.
+     * @param ctx Context to load the script into.
+     * @param source Code of the script.
+     * @param filename Name of the script in stack traces, part of the cache key.
+     * @return The compiled script.
+     * @throws js_error if the script fails to parse.
+     */
+    script compile(context &ctx, std::string_view source, const char *filename = "<eval>");
+
+    /**
+     * @brief Evaluate a script, loading it from the cache if possible.
+     * @see compile
+     * @param ctx Context to run the script in.
+     * @param source Code of the script.
+     * @param filename Name of the script in stack traces, part of the cache key.
+     * @return Completion value of the script, or an exception.
+     * @throws js_error if the script fails to parse.
+     */
+    value eval(context &ctx, std::string_view source, const char *filename = "<eval>") {
+        return compile(ctx, source, filename).run();
+    }
+
+    /**
+     * @brief Get the number of scripts loaded from the cache.
+     * @return Number of cache hits.
+     */
+    [[nodiscard]] uint64_t hits() const { return _hits.load(std::memory_order_relaxed); }
+    /**
+     * @brief Get the number of scripts that had to be compiled.
+     * @return Number of cache misses.
+     */
+    [[nodiscard]] uint64_t misses() const { return _misses.load(std::memory_order_relaxed); }
+
+  private:
+    std::filesystem::path _dir;
+    std::atomic<uint64_t> _hits = 0;
+    std::atomic<uint64_t> _misses = 0;
+};
+
+} // namespace jnjs
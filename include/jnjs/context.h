@@ -2,10 +2,16 @@
 
 #ifndef JNJS_IMPL_USING_MODULE
 #include <memory>
+#include <cstdint>
+#include <cstring>
 #include <quickjs.h>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "binding.h"
+#include "memory.h"
+#include "script.h"
 #include "value.h"
 
 #include "detail/function_helpers.h"
@@ -23,11 +29,93 @@ class context : detail::impl_ptr<JSContext> {
   public:
     ~context() = default;
 
+    JNJS_IMPL_NON_COPYABLE(context)
+    context(context &&) noexcept = default;
+    context &operator=(context &&) noexcept = default;
+
     value eval(std::string_view code) {
+        const detail::run_scope running(get());
         auto v = JS_Eval(get(), code.data(), code.size(), "<eval>", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT);
         return value(v, get());
     }
 
+    /**
+     * @brief Parse JSON text, like `JSON.parse`.
+     * @note The parser needs a null terminated buffer, so the text is copied first; pass a `std::string` or C string
+     * to avoid that.
+     * @param json JSON text.
+     * @param filename Name of the source in syntax errors.
+     * @return The parsed value, or an exception convertible to js_error if the text is not valid JSON.
+     */
+    value parse_json(std::string_view json, const char *filename = "<json>") {
+        const std::string buf(json);
+        return parse_json(buf, filename);
+    }
+    /**
+     * @brief Parse JSON text, like `JSON.parse`.
+     * @param json JSON text.
+     * @param filename Name of the source in syntax errors.
+     * @return The parsed value, or an exception convertible to js_error if the text is not valid JSON.
+     */
+    value parse_json(const std::string &json, const char *filename = "<json>") {
+        return value(JS_ParseJSON(get(), json.c_str(), json.size(), filename), get());
+    }
+    /**
+     * @brief Parse JSON text, like `JSON.parse`.
+     * @param json Null terminated JSON text.
+     * @param filename Name of the source in syntax errors.
+     * @return The parsed value, or an exception convertible to js_error if the text is not valid JSON.
+     */
+    HEDLEY_NON_NULL(2)
+    value parse_json(const char *json, const char *filename = "<json>") {
+        return value(JS_ParseJSON(get(), json, std::strlen(json), filename), get());
+    }
+
+    /**
+     * @brief Recreate a value serialized in any context, runtime or thread.
+     * @note A message can be read any number of times, every read creates a new copy of the value.
+     * @param s Message created by value::serialize.
+     * @return The value, undefined if the message is empty, or an exception convertible to js_error.
+     */
+    value deserialize(const serialized &s);
+    /**
+     * @brief Recreate a value from raw serialized bytes, e.g. received from another process.
+     * @note The bytes must not pass SharedArrayBuffers through, i.e. serialized::shared_buffers() was 0.
+     * @param data Serialized bytes.
+     * @param size Number of bytes.
+     * @return The value, or an exception convertible to js_error if the bytes are malformed.
+     */
+    value deserialize(const uint8_t *data, size_t size);
+
+    /**
+     * @brief Parse a script once, to run it any number of times later.
+     * @param source Code of the script.
+     * @param filename Name of the script in stack traces.
+     * @return The compiled script.
+     * @throws js_error if the script fails to parse.
+     */
+    script compile(std::string_view source, const char *filename = "<eval>");
+
+    /**
+     * @brief Get a property of the global object.
+     * @param name Name of the global.
+     * @return The global's value, or undefined if it does not exist.
+     */
+    value get_global(const char *name) {
+        auto ctx = get();
+        auto g = JS_GetGlobalObject(ctx);
+        auto v = JS_GetPropertyStr(ctx, g, name);
+        JS_FreeValue(ctx, g);
+        return value(v, ctx);
+    }
+
+    /**
+     * @brief Collect memory statistics for the runtime this context belongs to.
+     * @see runtime::memory_usage
+     * @return Current memory statistics.
+     */
+    [[nodiscard]] memory_stats memory_usage() const { return detail::compute_memory_stats(JS_GetRuntime(get())); }
+
     template <typename T> void set_global(const char *name, const T &v) {
         _set_global(name, detail::value_helpers<T>::from(get(), v));
     }
@@ -50,9 +138,20 @@ class context : detail::impl_ptr<JSContext> {
         JS_SetPropertyStr(ctx, g, name, v);
         JS_FreeValue(ctx, g);
     }
+    script _load_script(const uint8_t *data, size_t size);
+    std::vector<uint8_t> _write_script(const script &s);
     value _make_cfunc_value(const char *name, JSCFunction *fn, int len) const;
-    void _decl_class_impl(const detail::class_builder_data &, detail::internal_class_meta_data &o);
+    void _decl_class_impl(const detail::class_builder_data &, const detail::internal_class_meta_data &o);
+    void _decl_class_impl(const detail::class_builder_data &, const detail::internal_class_meta_data &o,
+                          JSValueConst global);
     friend runtime;
+    friend bundle;
+    friend bundle_writer;
+    friend bytecode_cache;
+    friend context_pool;
+    friend context_template;
+    friend execution_limit;
+    friend value_scope;
 };
 
 } // namespace jnjs
\ No newline at end of file
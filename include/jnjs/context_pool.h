@@ -0,0 +1,138 @@
+#pragma once
+/**
+ * @file context_pool.h
+ * @brief Pool of pre-initialised contexts.
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "context.h"
+#include "runtime.h"
+
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief Keeps fully set up contexts of one runtime ready to hand out.
+ *
+ * Setting up a context (installing classes, binding globals, running bootstrap scripts) often costs more than the
+ * script it is created for. A context_pool runs that setup ahead of time, lends contexts out one request at a time,
+ * and either reuses them or replaces them with fresh ones when they come back, according to its hygiene policy.
+ * acquire() creates extra contexts when none are ready; set policy::max_idle to destroy them again once a burst of
+ * leases is over.
+ *
+ * @warning Like its runtime, a pool must only be used from one thread, must outlive every lease it hands out, and
+ * values obtained from a leased context must be released before the lease is.
+ */
+class context_pool {
+    struct entry;
+
+  public:
+    /**
+     * @brief Function setting up a new context, e.g. installing classes and globals.
+     */
+    using init_fn = std::function<void(context &)>;
+
+    /**
+     * @brief When a returned context is discarded instead of reused.
+     */
+    struct policy {
+        /** Discard a context after it has been leased this many times, 0 for never. */
+        size_t max_uses = 0;
+        /**
+         * Discard a returned context when this many are already idle, 0 for never.
+         * @note acquire() creates contexts when none are idle, so without a cap a burst of concurrent leases grows the
+         * pool for good.
+         */
+        size_t max_idle = 0;
+        /**
+         * Discard a context when properties were added to or removed from its global object.
+         * @note Top level `let`, `const` and `class` declarations do not create global object properties, and are not
+         * detected.
+         */
+        bool discard_on_global_change = true;
+    };
+
+    /**
+     * @brief A context borrowed from the pool, returned to it on destruction.
+     */
+    class lease {
+      public:
+        ~lease() { _release(); }
+        lease(lease &&o) noexcept : _pool(o._pool), _e(o._e) { o._e = nullptr; }
+        lease &operator=(lease &&o) noexcept {
+            if (this != &o) {
+                _release();
+                _pool = o._pool;
+                _e = o._e;
+                o._e = nullptr;
+            }
+            return *this;
+        }
+        JNJS_IMPL_NON_COPYABLE(lease)
+
+        context &operator*() const;
+        context *operator->() const { return &**this; }
+
+      private:
+        lease(context_pool *pool, entry *e) : _pool(pool), _e(e) {}
+        void _release() {
+            if (_e != nullptr) {
+                _pool->_release(_e);
+                _e = nullptr;
+            }
+        }
+
+        context_pool *_pool;
+        entry *_e;
+        friend context_pool;
+    };
+
+    /**
+     * @brief Create a pool and set up its contexts.
+     * @param rt Runtime to create the contexts in, must outlive the pool.
+     * @param size Number of contexts to keep ready.
+     * @param init Function run on every new context.
+     */
+    context_pool(runtime &rt, size_t size, init_fn init = {});
+    /**
+     * @brief Create a pool and set up its contexts.
+     * @param rt Runtime to create the contexts in, must outlive the pool.
+     * @param size Number of contexts to keep ready.
+     * @param init Function run on every new context.
+     * @param p Hygiene policy for returned contexts.
+     */
+    context_pool(runtime &rt, size_t size, init_fn init, policy p);
+    ~context_pool();
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(context_pool)
+
+    /**
+     * @brief Borrow a context, creating a new one if none are ready.
+     * @return Lease on a set up context.
+     */
+    lease acquire();
+
+    /**
+     * @brief Get the number of contexts ready to be handed out.
+     * @return Number of idle contexts.
+     */
+    [[nodiscard]] size_t available() const { return _free.size(); }
+
+  private:
+    std::unique_ptr<entry> _make_entry();
+    void _release(entry *e);
+
+    runtime &_rt;
+    init_fn _init;
+    policy _policy;
+    std::vector<std::unique_ptr<entry>> _all;
+    std::vector<entry *> _free;
+};
+
+} // namespace jnjs
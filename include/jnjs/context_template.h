@@ -0,0 +1,125 @@
+#pragma once
+/**
+ * @file context_template.h
+ * @brief Recorded context setup, replayed onto new contexts.
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "context.h"
+#include "function.h"
+#include "runtime.h"
+
+#include "detail/types.h"
+
+namespace jnjs {
+
+/**
+ * @brief Recipe for setting up contexts: classes, globals and bootstrap scripts.
+ *
+ * Steps are recorded once and replayed onto every context the template is applied to. Bootstrap scripts are parsed
+ * the first time they run and kept as bytecode, which is shared by every later context, in any runtime and on any
+ * thread, so setting up another context never parses them again. Globals are all defined through a single lookup of
+ * the global object.
+ *
+ * @code
+ * jnjs::context_template tpl;
+ * tpl.install_class<my_class>().set_global_fn<&log>("log").eval("globalThis.helpers = { ... }");
+ * auto ctx = tpl.instantiate(rt);
+ * @endcode
+ *
+ * @warning Recording steps is not thread-safe. Once recording is done, apply() and instantiate() may be called from
+ * any number of threads at once.
+ */
+class context_template {
+  public:
+    context_template() = default;
+
+    /**
+     * @brief Record installing a class.
+     * @tparam K Class to install, see context::install_class.
+     * @return This template.
+     */
+    template <typename K, typename = std::enable_if_t<detail::has_build_v<K>, void>> context_template &install_class() {
+        constexpr static wrapped_class_builder<K> binder = K::build_js_class();
+        _classes.push_back({&binder._d, &detail::internal_class_meta<K>::data});
+        return *this;
+    }
+
+    /**
+     * @brief Record setting a global to a copy of `v`.
+     * @tparam T Type of the value, must be copyable.
+     * @param name Name of the global.
+     * @param v Value to set.
+     * @return This template.
+     */
+    template <typename T> context_template &set_global(std::string name, T v) {
+        auto make = [v = std::move(v)](JSContext *ctx, const char *) { return detail::value_helpers<T>::from(ctx, v); };
+        _globals.push_back({std::move(name), std::move(make)});
+        return *this;
+    }
+
+    /**
+     * @brief Record binding a global function.
+     * @tparam Func Function to bind, see context::set_global_fn.
+     * @param name Name of the global.
+     * @return This template.
+     */
+    template <auto Func> context_template &set_global_fn(std::string name) {
+        using helper = detail::binder<Func>;
+        auto make = [](JSContext *ctx, const char *n) {
+            return JS_NewCFunction(ctx, helper::call, n, helper::num_args);
+        };
+        _globals.push_back({std::move(name), make});
+        return *this;
+    }
+
+    /**
+     * @brief Record a bootstrap script, run after every class and global has been set up.
+     * @param code Code of the script.
+     * @param filename Name of the script in stack traces.
+     * @return This template.
+     */
+    context_template &eval(std::string code, std::string filename = "<bootstrap>");
+
+    /**
+     * @brief Replay the template onto a context.
+     * @param ctx Context to set up.
+     * @throws js_error if a bootstrap script fails to parse or throws.
+     */
+    void apply(context &ctx) const;
+
+    /**
+     * @brief Create a new context and set it up.
+     * @param rt Runtime to create the context in.
+     * @return The new context.
+     * @throws js_error if a bootstrap script fails to parse or throws.
+     */
+    [[nodiscard]] context instantiate(runtime &rt) const {
+        auto ctx = rt.make_context();
+        apply(ctx);
+        return ctx;
+    }
+
+  private:
+    struct class_step {
+        const detail::class_builder_data *d;
+        const detail::internal_class_meta_data *o;
+    };
+    struct global_step {
+        std::string name;
+        std::function<JSValue(JSContext *, const char *)> make;
+    };
+    struct script;
+
+    std::vector<class_step> _classes;
+    std::vector<global_step> _globals;
+    std::vector<std::shared_ptr<script>> _scripts;
+};
+
+} // namespace jnjs
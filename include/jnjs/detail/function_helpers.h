@@ -15,6 +15,10 @@
 
 #include "fwd.h"
 #include "hedley.h"
+#include "../borrowed_value.h"
+#include "../string_ref.h"
+#include "runtime_data.h"
+#include "simd.h"
 #include "type_traits.h"
 #include "types.h"
 #include "value_helpers.h"
@@ -159,14 +163,58 @@ template <typename T> struct getter<remaining_args<T>> {
         if (HEDLEY_UNLIKELY(i >= argc)) {
             return {};
         }
+        const auto first = i;
         remaining_args<T> ret(argc - i);
+        // numbers are unboxed in bulk, up to the first argument needing a conversion
+        if constexpr (std::is_same_v<T, int32_t>) {
+            i += static_cast<int>(simd::unbox_int32(argv + i, ret.size(), ret.data()));
+        } else if constexpr (std::is_same_v<T, double>) {
+            i += static_cast<int>(simd::unbox_float64(argv + i, ret.size(), ret.data()));
+        }
         for (int j = i; j < argc; ++j) {
-            ret.at(j - i) = std::move(getter<T>::get(ctx, argc, argv, j));
+            ret.at(j - first) = std::move(getter<T>::get(ctx, argc, argv, j));
         }
         return ret;
     }
 };
 
+/**
+ * @internal
+ * @brief Borrow a string from the argument list.
+ */
+template <> struct getter<string_ref> {
+    HEDLEY_NON_NULL(1, 3)
+    static string_ref get(JSContext *ctx, int argc, JSValue *argv, int i) {
+        using H = value_helpers<string_ref>;
+        if (HEDLEY_UNLIKELY(i >= argc)) {
+            throw js_exception(JS_ThrowRangeError(ctx, "Argument out of range (%d >= %d)", i, argc));
+        }
+        if (HEDLEY_UNLIKELY(!H::is_convertible(ctx, argv[i]))) {
+            throw js_exception(JS_ThrowTypeError(ctx, "Argument %d is not convertible to a string", i));
+        }
+        auto s = H::as(ctx, argv[i]);
+        // converting an object calls its toString, which can throw
+        if (HEDLEY_UNLIKELY(!s.valid())) {
+            throw js_exception(JS_EXCEPTION);
+        }
+        return s;
+    }
+};
+
+/**
+ * @internal
+ * @brief Borrow an argument for the duration of the call.
+ */
+template <> struct getter<borrowed_value> {
+    HEDLEY_NON_NULL(1, 3)
+    static borrowed_value get(JSContext *ctx, int argc, JSValue *argv, int i) {
+        if (HEDLEY_UNLIKELY(i >= argc)) {
+            throw js_exception(JS_ThrowRangeError(ctx, "Argument out of range (%d >= %d)", i, argc));
+        }
+        return value_helpers<borrowed_value>::borrow(ctx, argv[i], argv);
+    }
+};
+
 /**
  * @internal
  * @brief Specialization to avoid copying JSValue objects from the argument list.
@@ -261,13 +309,25 @@ static JSValue set(JSContext *ctx, const T &v) {
  * @internal
  * @brief Get a C++ class instance from a JS this object.
  * @tparam T Class of expected value of this
+ * @tparam H Either JSContext or JSRuntime, used to look up the runtime's class ID.
+ * @param h Context or runtime owning `js_this`.
  * @param js_this Value of this in a JS function call
  * @return Pointer to the C++ class instance associated with this JS object, or nullptr if not found.
  */
-template <typename T> static T *get_class(JSValue js_this) {
-    return static_cast<T *>(this_getter::get(js_this, internal_class_meta<T>::data.id));
+template <typename T, typename H> static T *get_class(H *h, JSValue js_this) {
+    return static_cast<T *>(this_getter::get(js_this, class_id<T>(h)));
 }
 
+/**
+ * @internal
+ * @brief Checks that no borrowed arguments outlive a call, with JNJS_DEBUG_BORROWS.
+ */
+struct borrow_frame {
+    JSContext *ctx;
+    const JSValue *argv;
+    ~borrow_frame() { check_unborrowed(ctx, argv); }
+};
+
 /**
  * @internal
  * @brief Assert that a function was called with `new`.
@@ -316,8 +376,8 @@ template <auto Func> struct binder {
         template <std::size_t... Is>
         HEDLEY_NON_NULL(1, 3)
         HEDLEY_PURE static ret_type invoke(JSContext *ctx, int argc, JSValue *argv, std::index_sequence<Is...>) {
-            return Func(std::forward<getter_type_t<TArgs> &&>(
-                arg_list_helpers::get<getter_type_t<TArgs>>(ctx, argc, argv, Is))...);
+            return Func(std::forward<arg_type_t<TArgs> &&>(
+                arg_list_helpers::get<arg_type_t<TArgs>>(ctx, argc, argv, Is))...);
         }
 
         /**
@@ -362,6 +422,7 @@ template <auto Func> struct binder {
      */
     HEDLEY_NON_NULL(1, 4)
     static JSValue call(JSContext *ctx, JSValue, int argc, JSValue *argv) {
+        const arg_list_helpers::borrow_frame frame{ctx, argv};
         try {
             return inner::call_impl(ctx, argc, argv);
         } catch (js_exception &e) {
@@ -383,6 +444,7 @@ template <auto Func> struct binder {
     static JSValue call_ctor_t(JSContext *ctx, JSValue func_obj, JSValue js_this, int argc, JSValue *argv, int flags) {
         (void)func_obj; // idk what use we'd have for this
         (void)flags;    // idk what this even does
+        const arg_list_helpers::borrow_frame frame{ctx, argv};
         try {
             arg_list_helpers::assert_called_new(ctx, js_this);
             return inner::call_impl(ctx, argc, argv);
@@ -428,9 +490,9 @@ template <typename Klass, auto Func> struct class_binder {
         template <std::size_t... Is>
         HEDLEY_NON_NULL(1, 4)
         static ret_type invoke(JSContext *ctx, JSValue js_this, int argc, JSValue *argv, std::index_sequence<Is...>) {
-            Klass *kThis = arg_list_helpers::get_class<Klass>(js_this);
-            return (kThis->*Func)(std::forward<getter_type_t<TArgs> &&>(
-                arg_list_helpers::get<getter_type_t<TArgs>>(ctx, argc, argv, Is))...);
+            Klass *kThis = arg_list_helpers::get_class<Klass>(ctx, js_this);
+            return (kThis->*Func)(std::forward<arg_type_t<TArgs> &&>(
+                arg_list_helpers::get<arg_type_t<TArgs>>(ctx, argc, argv, Is))...);
         }
 
         template <typename TRetI = TRet>
@@ -454,6 +516,7 @@ template <typename Klass, auto Func> struct class_binder {
     static constexpr size_t num_args = inner::num_args;
     HEDLEY_NON_NULL(1, 4)
     static JSValue call(JSContext *ctx, JSValue js_this, int argc, JSValue *argv) {
+        const arg_list_helpers::borrow_frame frame{ctx, argv};
         try {
             return inner::call_impl(ctx, js_this, argc, argv);
         } catch (js_exception &e) {
@@ -475,6 +538,7 @@ template <typename Klass, auto Func> struct class_binder {
     HEDLEY_NON_NULL(1)
     static JSValue call_set(JSContext *ctx, JSValue js_this, JSValue arg) {
         static_assert(num_args == 1, "setter must have 1 argument");
+        const arg_list_helpers::borrow_frame frame{ctx, &arg};
         try {
             return inner::call_impl(ctx, js_this, 1, &arg);
         } catch (js_exception &e) {
@@ -23,10 +23,22 @@ template <typename T, typename = void> struct value_helpers {
 
 template <typename T> struct wrapped_class_builder;
 
+template <typename C> class array_ref;
+class borrowed_value;
+class bundle;
+class bundle_writer;
+class bytecode_cache;
 class context;
+class context_pool;
+class context_template;
+class execution_limit;
 class function;
 class module;
 class runtime;
+class script;
+class serialized;
+class string_ref;
 class value;
+class value_scope;
 
 } // namespace jnjs
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+/**
+ * @file indexer.h
+ * @brief Exotic class methods forwarding indexed properties to a C++ object.
+ * @internal
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+
+#include <quickjs.h>
+
+#include "function_helpers.h"
+#include "hedley.h"
+#include "value_helpers.h"
+
+namespace jnjs::detail {
+
+/**
+ * @internal
+ * @brief Parse an atom as an array index.
+ * @param ctx JS context.
+ * @param atom Property name.
+ * @param out Receives the index.
+ * @return If the atom is a canonical array index.
+ */
+inline bool atom_to_index(JSContext *ctx, JSAtom atom, uint32_t &out) {
+    // QuickJS stores indices below 2^31 in the atom itself, the guess is confirmed through the public API
+    constexpr uint32_t int_tag = 1U << 31;
+    if (HEDLEY_LIKELY((atom & int_tag) != 0)) {
+        const auto a = JS_NewAtomUInt32(ctx, atom & ~int_tag);
+        JS_FreeAtom(ctx, a);
+        if (HEDLEY_LIKELY(a == atom)) {
+            out = atom & ~int_tag;
+            return true;
+        }
+    }
+    size_t len;
+    const auto *s = JS_AtomToCStringLen(ctx, &len, atom);
+    if (s == nullptr) {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        return false;
+    }
+    const std::string_view name(s, len);
+    uint64_t n = 0;
+    bool ok = !name.empty() && name.size() <= 10 && (name.size() == 1 || name[0] != '0');
+    for (auto ch : name) {
+        ok = ok && ch >= '0' && ch <= '9';
+        n = n * 10 + static_cast<uint64_t>(ch - '0');
+    }
+    JS_FreeCString(ctx, s);
+    // 2^32 - 1 is the largest length, not an index
+    if (!ok || n >= UINT32_MAX)
+        return false;
+    out = static_cast<uint32_t>(n);
+    return true;
+}
+
+template <typename T> struct indexer_set_arg;
+template <typename K, typename R, typename I, typename A> struct indexer_set_arg<R (K::*)(I, A)> {
+    using type = std::remove_cvref_t<A>;
+};
+
+/**
+ * @internal
+ * @brief Exotic methods exposing the elements of a bound class as indexed properties.
+ * @tparam Klass Bound class.
+ * @tparam Size Member function returning the number of elements.
+ * @tparam Get Member function returning the element at an index.
+ * @tparam Set Member function storing an element at an index, or nullptr.
+ */
+template <typename Klass, auto Size, auto Get, auto Set> struct indexer {
+    using element_type = std::remove_cvref_t<std::invoke_result_t<decltype(Get), Klass &, size_t>>;
+    constexpr static bool writable = !std::is_null_pointer_v<decltype(Set)>;
+
+    static Klass *self(JSContext *ctx, JSValueConst obj) { return arg_list_helpers::get_class<Klass>(ctx, obj); }
+    static bool index_of(JSContext *ctx, Klass *k, JSAtom prop, size_t &out) {
+        uint32_t i;
+        if (k == nullptr || !atom_to_index(ctx, prop, i) || i >= static_cast<size_t>(std::invoke(Size, *k)))
+            return false;
+        out = i;
+        return true;
+    }
+
+    static JSValue length(JSContext *ctx, JSValueConst this_val) {
+        auto *k = self(ctx, this_val);
+        if (HEDLEY_UNLIKELY(k == nullptr))
+            return JS_ThrowTypeError(ctx, "Not an instance of the bound class");
+        return value_helpers<int64_t>::from(ctx, static_cast<int64_t>(std::invoke(Size, *k)));
+    }
+
+    static int get_own_property(JSContext *ctx, JSPropertyDescriptor *desc, JSValueConst obj, JSAtom prop) {
+        auto *k = self(ctx, obj);
+        size_t i;
+        if (!index_of(ctx, k, prop, i))
+            return false;
+        if (desc != nullptr) {
+            try {
+                desc->value = value_helpers<element_type>::from(ctx, std::invoke(Get, *k, i));
+            } catch (js_exception &) {
+                return -1;
+            }
+            desc->flags = JS_PROP_ENUMERABLE | (writable ? JS_PROP_WRITABLE : 0);
+            desc->getter = JS_UNDEFINED;
+            desc->setter = JS_UNDEFINED;
+        }
+        return true;
+    }
+
+    static int get_own_property_names(JSContext *ctx, JSPropertyEnum **ptab, uint32_t *plen, JSValueConst obj) {
+        auto *k = self(ctx, obj);
+        const auto n = k != nullptr ? static_cast<uint32_t>(std::invoke(Size, *k)) : 0;
+        auto *tab = static_cast<JSPropertyEnum *>(js_malloc(ctx, sizeof(JSPropertyEnum) * (n > 0 ? n : 1)));
+        if (HEDLEY_UNLIKELY(tab == nullptr))
+            return -1;
+        for (uint32_t i = 0; i < n; ++i) {
+            tab[i].is_enumerable = true;
+            tab[i].atom = JS_NewAtomUInt32(ctx, i);
+        }
+        *ptab = tab;
+        *plen = n;
+        return 0;
+    }
+
+    static int define_own_property(JSContext *ctx, JSValueConst this_obj, JSAtom prop, JSValueConst val,
+                                   JSValueConst, JSValueConst, int flags) {
+        auto *k = self(ctx, this_obj);
+        size_t i;
+        if constexpr (writable) {
+            using arg_type = typename indexer_set_arg<decltype(Set)>::type;
+            if ((flags & (JS_PROP_HAS_GET | JS_PROP_HAS_SET)) == 0 && (flags & JS_PROP_HAS_VALUE) != 0 &&
+                index_of(ctx, k, prop, i)) {
+                if (HEDLEY_UNLIKELY(!value_helpers<arg_type>::is_convertible(ctx, val))) {
+                    JS_ThrowTypeError(ctx, "Element is not of type %s", typeid(arg_type).name());
+                    return -1;
+                }
+                try {
+                    std::invoke(Set, *k, i, value_helpers<arg_type>::as(ctx, val));
+                } catch (js_exception &) {
+                    return -1;
+                }
+                return true;
+            }
+        }
+        // elements can not be added, removed or turned into accessors, and other properties can not be added
+        if ((flags & (JS_PROP_THROW | JS_PROP_THROW_STRICT)) != 0) {
+            JS_ThrowTypeError(ctx, "Cannot define property on a C++ backed array");
+            return -1;
+        }
+        return false;
+    }
+
+    static int delete_property(JSContext *ctx, JSValueConst obj, JSAtom prop) {
+        size_t i;
+        return !index_of(ctx, self(ctx, obj), prop, i);
+    }
+
+    static inline JSClassExoticMethods methods = [] {
+        JSClassExoticMethods m = {};
+        m.get_own_property = get_own_property;
+        m.get_own_property_names = get_own_property_names;
+        m.delete_property = delete_property;
+        m.define_own_property = define_own_property;
+        return m;
+    }();
+};
+
+} // namespace jnjs::detail
@@ -0,0 +1,175 @@
+#pragma once
+/**
+ * @file runtime_data.h
+ * @brief State jnjs keeps alongside every JSRuntime.
+ * @internal
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "../allocator.h"
+#include "fwd.h"
+#include "hedley.h"
+#include "types.h"
+#include "util.h"
+
+/**
+ * @brief Check that no borrowed_value outlives the value or call it borrows from, aborting if one does.
+ *
+ * Set by the JNJS_DEBUG_BORROWS CMake option, which is exported with the jnjs target so the library and everything
+ * linking it agree. It must not differ between translation units, so it is deliberately not derived from NDEBUG.
+ */
+#ifndef JNJS_DEBUG_BORROWS
+#define JNJS_DEBUG_BORROWS 0
+#endif
+
+namespace jnjs::detail {
+
+/**
+ * @internal
+ * @brief Limits armed by an execution_limit, checked from the interrupt handler.
+ */
+struct interrupt_frame {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    uint64_t budget = UINT64_MAX;                     /**< @internal Interrupt checks left, UINT64_MAX if unlimited. */
+    interrupt_reason reason = interrupt_reason::none; /**< @internal Set when this frame interrupted a script. */
+    interrupt_frame *prev = nullptr;                  /**< @internal Enclosing frame. */
+};
+
+/**
+ * @internal
+ * @brief Per-runtime state, stored as the runtime opaque.
+ */
+struct runtime_data {
+    std::vector<JSClassID> class_ids; /**< @internal QuickJS class IDs, indexed by internal_class_meta_data::index. */
+    std::unique_ptr<allocator> alloc; /**< @internal Custom allocator, must outlive the JSRuntime. */
+    uint64_t explicit_gc_runs = 0;    /**< @internal Number of runtime::run_gc calls. */
+
+    /** @internal Set from any thread to interrupt the running script. */
+    std::shared_ptr<std::atomic<bool>> terminate = std::make_shared<std::atomic<bool>>(false);
+    uint32_t run_depth = 0;           /**< @internal Number of nested evaluations and calls in progress. */
+    interrupt_frame *limit = nullptr; /**< @internal Innermost armed execution_limit. */
+    /** @internal Reason for the most recent interrupt, until it is taken with as<interrupted_error>(). */
+    interrupt_reason last_interrupt = interrupt_reason::none;
+    std::shared_ptr<const bundle> modules; /**< @internal Bundle modules are imported from. */
+    std::vector<JSAtom> atoms; /**< @internal Cached prop_key atoms, indexed by key index, JS_ATOM_NULL if unused. */
+    /** @internal Live borrowed_values per owner, only tracked with JNJS_DEBUG_BORROWS. */
+    std::unordered_map<const void *, uint32_t> borrows;
+
+    /**
+     * @internal
+     * @brief Get the jnjs state attached to a runtime.
+     * @param rt Runtime created by jnjs::runtime.
+     * @return The runtime's state.
+     */
+    HEDLEY_NON_NULL(1)
+    static runtime_data &get(JSRuntime *rt) { return *static_cast<runtime_data *>(JS_GetRuntimeOpaque(rt)); }
+    HEDLEY_NON_NULL(1)
+    static runtime_data &get(JSContext *ctx) { return get(JS_GetRuntime(ctx)); }
+
+    /**
+     * @internal
+     * @brief Look up the class ID a class was registered with in this runtime.
+     * @param d Class metadata.
+     * @return The QuickJS class ID, or 0 if the class was never installed in this runtime.
+     */
+    [[nodiscard]] JSClassID class_id(const internal_class_meta_data &d) const {
+        return HEDLEY_LIKELY(d.index < class_ids.size()) ? class_ids[d.index] : 0;
+    }
+};
+
+/**
+ * @internal
+ * @brief Record a borrow of `owner` being created or released, with JNJS_DEBUG_BORROWS.
+ * @param ctx JS context.
+ * @param owner Address of the value or argument list borrowed from, ignored if nullptr.
+ * @param delta 1 for a new borrow, -1 for a released one.
+ */
+inline void track_borrow([[maybe_unused]] JSContext *ctx, [[maybe_unused]] const void *owner,
+    [[maybe_unused]] int delta) {
+#if JNJS_DEBUG_BORROWS
+    if (ctx == nullptr || owner == nullptr)
+        return;
+    auto &b = runtime_data::get(ctx).borrows;
+    if (delta > 0) {
+        ++b[owner];
+    } else if (auto it = b.find(owner); it != b.end() && --it->second == 0) {
+        b.erase(it);
+    }
+#endif
+}
+
+/**
+ * @internal
+ * @brief Abort if `owner` is still borrowed from, with JNJS_DEBUG_BORROWS.
+ * @param ctx JS context.
+ * @param owner Address of a value or argument list about to be released.
+ */
+inline void check_unborrowed([[maybe_unused]] JSContext *ctx, [[maybe_unused]] const void *owner) {
+#if JNJS_DEBUG_BORROWS
+    if (ctx == nullptr)
+        return;
+    const auto &b = runtime_data::get(ctx).borrows;
+    if (HEDLEY_UNLIKELY(!b.empty() && b.contains(owner))) {
+        std::fputs("jnjs: a borrowed_value outlived the value it borrows from\n", stderr);
+        std::abort();
+    }
+#endif
+}
+
+/**
+ * @internal
+ * @brief Marks an evaluation or call from C++ as in progress.
+ *
+ * The outermost one drops termination requests made while the runtime was idle, so terminate_handle only ever stops
+ * the script that was running when it was called, and forgets the previous interrupt, so an exception of this run is
+ * only reported as interrupted_error if this run was interrupted.
+ */
+class run_scope {
+  public:
+    HEDLEY_NON_NULL(2)
+    explicit run_scope(JSContext *ctx) : _d(runtime_data::get(ctx)) {
+        if (_d.run_depth++ == 0) {
+            _d.terminate->store(false, std::memory_order_relaxed);
+            _d.last_interrupt = interrupt_reason::none;
+        }
+    }
+    ~run_scope() { --_d.run_depth; }
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(run_scope)
+
+  private:
+    runtime_data &_d;
+};
+
+/**
+ * @internal
+ * @brief Get the class ID of `T` in the runtime owning a context.
+ * @tparam T Bound class.
+ * @param ctx JS context.
+ * @return The QuickJS class ID, or 0 if `T` is not installed.
+ */
+template <typename T> JSClassID class_id(JSContext *ctx) {
+    return runtime_data::get(ctx).class_id(internal_class_meta<T>::data);
+}
+/**
+ * @internal
+ * @brief Get the class ID of `T` in a runtime.
+ * @tparam T Bound class.
+ * @param rt JS runtime.
+ * @return The QuickJS class ID, or 0 if `T` is not installed.
+ */
+template <typename T> JSClassID class_id(JSRuntime *rt) {
+    return runtime_data::get(rt).class_id(internal_class_meta<T>::data);
+}
+
+} // namespace jnjs::detail
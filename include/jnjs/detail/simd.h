@@ -0,0 +1,53 @@
+#pragma once
+/**
+ * @file simd.h
+ * @brief Vectorized boxing and unboxing of numeric JSValues.
+ * @internal
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <quickjs.h>
+
+namespace jnjs::detail::simd {
+
+/**
+ * @internal
+ * @brief Unbox a run of int JSValues.
+ * @param in Values to unbox.
+ * @param n Number of values.
+ * @param out Receives the unboxed values, must hold `n` elements.
+ * @return Number of leading values unboxed, stops at the first value that is not an int.
+ */
+size_t unbox_int32(const JSValue *in, size_t n, int32_t *out);
+
+/**
+ * @internal
+ * @brief Unbox a run of number JSValues, ints or doubles.
+ * @param in Values to unbox.
+ * @param n Number of values.
+ * @param out Receives the unboxed values, must hold `n` elements.
+ * @return Number of leading values unboxed, stops at the first value that is not a number.
+ */
+size_t unbox_float64(const JSValue *in, size_t n, double *out);
+
+/**
+ * @internal
+ * @brief Box ints into JSValues.
+ * @param in Values to box.
+ * @param n Number of values.
+ * @param out Receives the JSValues, must hold `n` elements.
+ */
+void box_int32(const int32_t *in, size_t n, JSValue *out);
+
+/**
+ * @internal
+ * @brief Box doubles into JSValues, integral ones as ints like value_helpers<double>::from.
+ * @param in Values to box.
+ * @param n Number of values.
+ * @param out Receives the JSValues, must hold `n` elements.
+ */
+void box_float64(const double *in, size_t n, JSValue *out);
+
+} // namespace jnjs::detail::simd
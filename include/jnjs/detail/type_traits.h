@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+#include <string_view>
 #include <type_traits>
 
 #include "fwd.h"
@@ -42,4 +44,26 @@ template <typename T> struct getter_type<const T *> {
 };
 template <typename T> using getter_type_t = typename getter_type<T>::type;
 
+/**
+ * @internal
+ * @brief Type a bound function's argument is read into, and which lives until the function returns.
+ *
+ * Same as getter_type, except that string views and C strings are read into a string_ref, so they can borrow the
+ * string's contents instead of copying them.
+ */
+template <typename T> struct arg_type {
+    using type =
+        std::conditional_t<std::is_same_v<remove_ref_cv_t<T>, std::string_view>, string_ref, getter_type_t<T>>;
+};
+template <> struct arg_type<const char *> {
+    using type = string_ref;
+};
+template <> struct arg_type<std::optional<std::string_view>> {
+    using type = std::optional<string_ref>;
+};
+template <> struct arg_type<const std::optional<std::string_view> &> {
+    using type = std::optional<string_ref>;
+};
+template <typename T> using arg_type_t = typename arg_type<T>::type;
+
 } // namespace jnjs::detail
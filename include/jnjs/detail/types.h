@@ -1,10 +1,28 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 namespace jnjs {
 
 namespace detail {
+/**
+ * @internal
+ * @brief Allocate a process-wide index for a bound class.
+ * @return A new class index, unique for the lifetime of the process.
+ */
+inline uint32_t next_class_index() {
+    static std::atomic<uint32_t> counter = 0;
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @internal
+ * @brief Per-class metadata shared by every runtime.
+ * @note The QuickJS class ID is allocated separately by each runtime, see runtime_data::class_ids.
+ */
 struct internal_class_meta_data {
-    uint32_t id = 0;
+    const uint32_t index = next_class_index(); /**< @internal Index into runtime_data::class_ids. */
 };
 template <typename T> struct internal_class_meta {
     static inline internal_class_meta_data data = {};
@@ -13,6 +31,16 @@ template <typename T> struct internal_class_meta {
 template <typename T, typename = void> constexpr bool has_build_v = false;
 } // namespace detail
 
+/**
+ * @brief Why a running script was interrupted.
+ */
+enum class interrupt_reason : uint8_t {
+    none,       /**< The script was not interrupted. */
+    deadline,   /**< The execution_limit's timeout expired. */
+    budget,     /**< The execution_limit's instruction budget ran out. */
+    terminated, /**< terminate_handle::terminate was called. */
+};
+
 struct undefined {};
 struct null {};
 template <typename T> struct must_be {
@@ -23,4 +51,4 @@ template <typename T> struct must_be {
     T v;
 };
 
-} // namespace jnjs
\ No newline at end of file
+} // namespace jnjs
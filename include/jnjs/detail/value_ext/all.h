@@ -1,6 +1,8 @@
 #pragma once
 
+#include "./fields.h"
+#include "./map.h"
 #include "./optional.h"
+#include "./span.h"
 #include "./string.h"
-#include "./unordered_map.h"
 #include "./vector.h"
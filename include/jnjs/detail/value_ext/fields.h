@@ -0,0 +1,105 @@
+#pragma once
+
+#include <quickjs.h>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../../error.h"
+#include "../../prop_key.h"
+#include "../fwd.h"
+#include "../hedley.h"
+
+/**
+ * @brief Declare the fields of an aggregate, making it convertible to and from a plain JS object.
+ *
+ * Must be used in the namespace the type is declared in, or as a friend declaration inside it. Every field type must
+ * itself be convertible, and the type must be default constructible. Properties missing from a JS object leave the
+ * field at its default value.
+ *
+ * @code
+ * struct point {
+ *     int x;
+ *     int y;
+ * };
+ * JNJS_FIELDS(point, x, y)
+ * @endcode
+ */
+#define JNJS_FIELDS(type, ...)                                                                                         \
+    constexpr auto jnjs_fields(const type *) {                                                                         \
+        return std::make_tuple(JNJS_IMPL_FOR_EACH(JNJS_IMPL_FIELD, type, __VA_ARGS__));                                \
+    }
+
+#define JNJS_IMPL_FIELD(type, name) ::jnjs::detail::field{&::jnjs::key<#name>, &type::name}
+
+#define JNJS_IMPL_PARENS ()
+#define JNJS_IMPL_EXPAND(...) JNJS_IMPL_EXPAND3(JNJS_IMPL_EXPAND3(JNJS_IMPL_EXPAND3(JNJS_IMPL_EXPAND3(__VA_ARGS__))))
+#define JNJS_IMPL_EXPAND3(...) JNJS_IMPL_EXPAND2(JNJS_IMPL_EXPAND2(JNJS_IMPL_EXPAND2(JNJS_IMPL_EXPAND2(__VA_ARGS__))))
+#define JNJS_IMPL_EXPAND2(...) JNJS_IMPL_EXPAND1(JNJS_IMPL_EXPAND1(JNJS_IMPL_EXPAND1(JNJS_IMPL_EXPAND1(__VA_ARGS__))))
+#define JNJS_IMPL_EXPAND1(...) __VA_ARGS__
+#define JNJS_IMPL_FOR_EACH(macro, type, ...)                                                                           \
+    __VA_OPT__(JNJS_IMPL_EXPAND(JNJS_IMPL_FOR_EACH_STEP(macro, type, __VA_ARGS__)))
+#define JNJS_IMPL_FOR_EACH_STEP(macro, type, first, ...)                                                               \
+    macro(type, first) __VA_OPT__(, JNJS_IMPL_FOR_EACH_AGAIN JNJS_IMPL_PARENS(macro, type, __VA_ARGS__))
+#define JNJS_IMPL_FOR_EACH_AGAIN() JNJS_IMPL_FOR_EACH_STEP
+
+namespace jnjs::detail {
+/**
+ * @internal
+ * @brief A field declared with JNJS_FIELDS.
+ * @tparam C Aggregate type.
+ * @tparam M Field type.
+ */
+template <typename C, typename M> struct field {
+    const prop_key *key;
+    M C::*member;
+};
+template <typename C, typename M> field(const prop_key *, M C::*) -> field<C, M>;
+
+template <typename T, typename = void> constexpr bool has_fields_v = false;
+template <typename T>
+constexpr bool has_fields_v<T, std::void_t<decltype(jnjs_fields(static_cast<const T *>(nullptr)))>> = true;
+} // namespace jnjs::detail
+
+/**
+ * @note Objects are created with all of their properties at once, from atoms cached per runtime, so every object of
+ * the same type shares one shape. Converting from JS throws js_error if a property getter throws.
+ */
+template <typename T> struct jnjs::detail::value_helpers<T, std::enable_if_t<jnjs::detail::has_fields_v<T>>> {
+    static bool is(JSContext *, JSValue v) { return JS_IsObject(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static T as(JSContext *c, JSValue v) {
+        T ret{};
+        std::apply([&](const auto &...f) { (read(c, v, f, ret), ...); }, fields);
+        return ret;
+    }
+    static JSValue from(JSContext *c, const T &v) {
+        constexpr auto n = std::tuple_size_v<decltype(fields)>;
+        std::array<JSAtom, n> atoms;
+        std::array<JSValue, n> vals;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((atoms[I] = std::get<I>(fields).key->atom(c)), ...);
+            ((vals[I] = write(c, v, std::get<I>(fields))), ...);
+        }(std::make_index_sequence<n>());
+        // takes ownership of the values
+        return JS_NewObjectFrom(c, static_cast<int>(n), atoms.data(), vals.data());
+    }
+
+  private:
+    constexpr static auto fields = jnjs_fields(static_cast<const T *>(nullptr));
+
+    template <typename M> static void read(JSContext *c, JSValue v, const field<T, M> &f, T &out) {
+        auto p = JS_GetProperty(c, v, f.key->atom(c));
+        if (HEDLEY_UNLIKELY(JS_IsException(p)))
+            throw value_helpers<js_error>::as(c, p);
+        if (!JS_IsUndefined(p))
+            out.*f.member = value_helpers<M>::as(c, p);
+        JS_FreeValue(c, p);
+    }
+    template <typename M> static JSValue write(JSContext *c, const T &v, const field<T, M> &f) {
+        return value_helpers<M>::from(c, v.*f.member);
+    }
+};
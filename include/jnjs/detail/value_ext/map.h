@@ -0,0 +1,251 @@
+#pragma once
+
+#include <quickjs.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+
+#include "../fwd.h"
+#include "../hedley.h"
+
+namespace jnjs {
+/**
+ * @brief A map kept as a vector of pairs sorted by key, converting to and from a plain JS object.
+ *
+ * Lookups are binary searches, and with the default `std::less<>` accept anything comparable to the key, e.g. a
+ * `std::string_view` for `std::string` keys.
+ * @tparam K Key type.
+ * @tparam V Mapped type.
+ * @tparam Compare Ordering of the keys.
+ */
+template <typename K, typename V, typename Compare = std::less<>>
+struct flat_map final : std::vector<std::pair<K, V>> {
+    using base = std::vector<std::pair<K, V>>;
+    using key_type = K;
+    using mapped_type = V;
+    using typename base::const_iterator;
+    using typename base::iterator;
+
+    flat_map() = default;
+    /**
+     * @brief Create a map from pairs in any order.
+     * @param il Pairs to insert, the first of duplicate keys wins.
+     */
+    flat_map(std::initializer_list<std::pair<K, V>> il) : base(il) { sort(); }
+
+    /**
+     * @brief Find an element by key.
+     * @param k Key to look up.
+     * @return Iterator to the element, or end() if there is none.
+     */
+    template <typename Q> iterator find(const Q &k) {
+        auto it = _lower_bound(*this, k);
+        return it != this->end() && !Compare{}(k, it->first) ? it : this->end();
+    }
+    template <typename Q> const_iterator find(const Q &k) const {
+        auto it = _lower_bound(*this, k);
+        return it != this->end() && !Compare{}(k, it->first) ? it : this->end();
+    }
+    /**
+     * @brief Check if an element with a key exists.
+     * @param k Key to look up.
+     * @return If the key was found.
+     */
+    template <typename Q> [[nodiscard]] bool contains(const Q &k) const { return find(k) != this->end(); }
+    /**
+     * @brief Get the value for a key.
+     * @param k Key to look up.
+     * @return The mapped value.
+     * @throws std::out_of_range if the key does not exist.
+     */
+    template <typename Q> V &at(const Q &k) {
+        auto it = find(k);
+        if (it == this->end())
+            throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+    template <typename Q> const V &at(const Q &k) const {
+        auto it = find(k);
+        if (it == this->end())
+            throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    /**
+     * @brief Insert an element, keeping the map sorted.
+     * @param k Key of the element.
+     * @param v Value of the element.
+     * @return Iterator to the element with the key, and if it was inserted.
+     */
+    std::pair<iterator, bool> emplace(K k, V v) {
+        auto it = _lower_bound(*this, k);
+        if (it != this->end() && !Compare{}(k, it->first))
+            return {it, false};
+        return {base::emplace(it, std::move(k), std::move(v)), true};
+    }
+
+    /**
+     * @brief Restore the ordering after elements were appended directly, dropping all but the first of duplicate keys.
+     */
+    void sort() {
+        std::stable_sort(this->begin(), this->end(), [](const auto &a, const auto &b) {
+            return Compare{}(a.first, b.first);
+        });
+        auto last = std::unique(this->begin(), this->end(), [](const auto &a, const auto &b) {
+            return !Compare{}(a.first, b.first);
+        });
+        this->erase(last, this->end());
+    }
+
+  private:
+    template <typename Self, typename Q> static auto _lower_bound(Self &self, const Q &k) {
+        return std::lower_bound(self.begin(), self.end(), k, [](const auto &e, const Q &q) {
+            return Compare{}(e.first, q);
+        });
+    }
+};
+} // namespace jnjs
+
+namespace jnjs::detail {
+/**
+ * @internal
+ * @brief Convert a property name to a map key, reading string keys without creating a JS string.
+ */
+template <typename K> K atom_to_key(JSContext *c, JSAtom a) {
+    if constexpr (std::is_same_v<K, std::string>) {
+        size_t len;
+        const auto *s = JS_AtomToCStringLen(c, &len, a);
+        if (HEDLEY_UNLIKELY(s == nullptr))
+            return {};
+        std::string ret(s, len);
+        JS_FreeCString(c, s);
+        return ret;
+    } else {
+        auto kv = JS_AtomToValue(c, a);
+        auto ret = value_helpers<K>::as(c, kv);
+        JS_FreeValue(c, kv);
+        return ret;
+    }
+}
+
+/**
+ * @internal
+ * @brief Convert a map key to a property name, directly from the bytes of strings and from small integers.
+ * @return A new atom, to be freed by the caller.
+ */
+template <typename K> JSAtom key_to_atom(JSContext *c, const K &k) {
+    if constexpr (std::is_convertible_v<const K &, std::string_view>) {
+        const std::string_view s = k;
+        return JS_NewAtomLen(c, s.data(), s.size());
+    } else {
+        if constexpr (std::is_integral_v<K> && !std::is_same_v<K, bool>) {
+            if (std::cmp_greater_equal(k, 0) && std::cmp_less_equal(k, INT32_MAX))
+                return JS_NewAtomUInt32(c, static_cast<uint32_t>(k));
+        }
+        auto jk = value_helpers<K>::from(c, k);
+        auto atom = JS_ValueToAtom(c, jk);
+        JS_FreeValue(c, jk);
+        return atom;
+    }
+}
+
+/**
+ * @internal
+ * @brief Read the own enumerable string keyed properties of an object.
+ * @param reserve Called once with the number of properties.
+ * @param add Called with each converted key and value, in property order.
+ */
+template <typename K, typename V, typename R, typename F>
+void read_properties(JSContext *c, JSValue v, R &&reserve, F &&add) {
+    JSPropertyEnum *tab;
+    uint32_t len;
+    if (JS_GetOwnPropertyNames(c, &tab, &len, v, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+        return;
+    }
+    reserve(len);
+    for (uint32_t i = 0; i < len; ++i) {
+        // the enumerated atom is reused for the lookup
+        auto val = JS_GetProperty(c, v, tab[i].atom);
+        add(atom_to_key<K>(c, tab[i].atom), value_helpers<V>::as(c, val));
+        JS_FreeValue(c, val);
+    }
+    JS_FreePropertyEnum(c, tab, len);
+}
+
+/**
+ * @internal
+ * @brief Conversions shared by every map type, to and from a plain JS object's own enumerable string keys.
+ * @tparam M Map type with `key_type`, `mapped_type` and `emplace(key, value)`.
+ */
+template <typename M> struct map_helpers {
+    using K = typename M::key_type;
+    using V = typename M::mapped_type;
+
+    static bool is(JSContext *, JSValue v) { return JS_IsObject(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static M as(JSContext *c, JSValue v) {
+        M ret;
+        read_properties<K, V>(
+            c, v,
+            [&](uint32_t n) {
+                if constexpr (requires { ret.reserve(n); })
+                    ret.reserve(n);
+            },
+            [&](K k, V val) { ret.emplace(std::move(k), std::move(val)); });
+        return ret;
+    }
+    static JSValue from(JSContext *c, const M &vm) {
+        auto rv = JS_NewObject(c);
+        for (const auto &[k, v] : vm) {
+            auto atom = key_to_atom(c, k);
+            JS_DefinePropertyValue(c, rv, atom, value_helpers<V>::from(c, v), JS_PROP_C_W_E);
+            JS_FreeAtom(c, atom);
+        }
+        return rv;
+    }
+};
+} // namespace jnjs::detail
+
+/**
+ * @note Custom hash and equality types are supported, e.g. transparent ones for `std::string_view` lookups.
+ */
+template <typename K, typename V, typename H, typename E, typename A>
+struct jnjs::detail::value_helpers<std::unordered_map<K, V, H, E, A>>
+    : map_helpers<std::unordered_map<K, V, H, E, A>> {};
+
+template <typename K, typename V, typename C, typename A>
+struct jnjs::detail::value_helpers<std::map<K, V, C, A>> : map_helpers<std::map<K, V, C, A>> {};
+
+/**
+ * @note Elements are appended in property order and sorted once at the end.
+ */
+template <typename K, typename V, typename C>
+struct jnjs::detail::value_helpers<jnjs::flat_map<K, V, C>> : map_helpers<jnjs::flat_map<K, V, C>> {
+    static flat_map<K, V, C> as(JSContext *c, JSValue v) {
+        flat_map<K, V, C> ret;
+        read_properties<K, V>(
+            c, v, [&](uint32_t n) { ret.reserve(n); },
+            [&](K k, V val) { ret.emplace_back(std::move(k), std::move(val)); });
+        ret.sort();
+        return ret;
+    }
+};
+
+#if defined(__cpp_lib_flat_map)
+template <typename K, typename V, typename C, typename KC, typename VC>
+struct jnjs::detail::value_helpers<std::flat_map<K, V, C, KC, VC>> : map_helpers<std::flat_map<K, V, C, KC, VC>> {};
+#endif
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <quickjs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "../fwd.h"
+
+namespace jnjs {
+
+/**
+ * @brief C++ owned memory handed to JS as an ArrayBuffer, without copying.
+ *
+ * The owner is kept alive until every ArrayBuffer created from the buffer has been garbage collected, and can be
+ * released from whichever thread runs the runtime. Converting the same external_buffer more than once creates
+ * ArrayBuffers sharing the same memory.
+ *
+ * @code
+ * std::vector<float> samples = load();
+ * ctx.set_global("samples", jnjs::external_buffer(std::move(samples)));
+ * // JS: new Float32Array(samples)
+ * @endcode
+ */
+class external_buffer {
+  public:
+    /**
+     * @brief Wrap memory kept alive by an owner.
+     * @param data Start of the memory.
+     * @param size Size of the memory in bytes.
+     * @param owner Object keeping `data` alive.
+     */
+    external_buffer(void *data, size_t size, std::shared_ptr<void> owner)
+        : _data(data), _size(size), _owner(std::move(owner)) {}
+
+    /**
+     * @brief Take ownership of a vector's storage.
+     * @tparam T Trivially copyable element type.
+     * @param v Vector to take over.
+     */
+    template <typename T> explicit external_buffer(std::vector<T> v) {
+        static_assert(std::is_trivially_copyable_v<T>, "external buffers must hold plain data");
+        auto p = std::make_shared<std::vector<T>>(std::move(v));
+        _data = p->data();
+        _size = p->size() * sizeof(T);
+        _owner = std::move(p);
+    }
+
+    [[nodiscard]] void *data() const { return _data; }
+    [[nodiscard]] size_t size() const { return _size; }
+
+  private:
+    void *_data = nullptr;
+    size_t _size = 0;
+    std::shared_ptr<void> _owner;
+    friend detail::value_helpers<external_buffer>;
+};
+
+namespace detail {
+/**
+ * @internal
+ * @brief TypedArray kind whose elements are `T`, or -1 if there is none.
+ */
+template <typename T> constexpr int typed_array_kind_v = -1;
+template <> constexpr int typed_array_kind_v<int8_t> = JS_TYPED_ARRAY_INT8;
+template <> constexpr int typed_array_kind_v<uint8_t> = JS_TYPED_ARRAY_UINT8;
+template <> constexpr int typed_array_kind_v<int16_t> = JS_TYPED_ARRAY_INT16;
+template <> constexpr int typed_array_kind_v<uint16_t> = JS_TYPED_ARRAY_UINT16;
+template <> constexpr int typed_array_kind_v<int32_t> = JS_TYPED_ARRAY_INT32;
+template <> constexpr int typed_array_kind_v<uint32_t> = JS_TYPED_ARRAY_UINT32;
+template <> constexpr int typed_array_kind_v<int64_t> = JS_TYPED_ARRAY_BIG_INT64;
+template <> constexpr int typed_array_kind_v<uint64_t> = JS_TYPED_ARRAY_BIG_UINT64;
+template <> constexpr int typed_array_kind_v<float> = JS_TYPED_ARRAY_FLOAT32;
+template <> constexpr int typed_array_kind_v<double> = JS_TYPED_ARRAY_FLOAT64;
+template <> constexpr int typed_array_kind_v<std::byte> = JS_TYPED_ARRAY_UINT8;
+template <typename T> constexpr bool is_typed_array_element_v = typed_array_kind_v<std::remove_const_t<T>> != -1;
+
+/**
+ * @internal
+ * @brief Check if a value's backing memory can be viewed as `T`s.
+ *
+ * Byte spans view ArrayBuffers and Uint8(Clamped)Arrays, `std::byte` spans view the bytes of any TypedArray, and
+ * every other element type needs a TypedArray of exactly that type.
+ */
+template <typename T> bool is_viewable_as(JSValue v) {
+    const auto kind = JS_GetTypedArrayType(v);
+    if constexpr (std::is_same_v<T, std::byte>) {
+        return kind >= 0 || JS_IsArrayBuffer(v);
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        return kind == JS_TYPED_ARRAY_UINT8 || kind == JS_TYPED_ARRAY_UINT8C || JS_IsArrayBuffer(v);
+    } else {
+        return kind == typed_array_kind_v<T>;
+    }
+}
+} // namespace detail
+
+} // namespace jnjs
+
+/**
+ * @brief Views the memory of an ArrayBuffer or TypedArray in place.
+ * @warning The span points into JS owned memory: it is only valid while the value it was taken from is alive, and
+ * until the buffer is detached or resized. Spans of bound function arguments are valid for the duration of the call.
+ * Converting a span to JS copies it into a new TypedArray.
+ */
+template <typename T>
+struct jnjs::detail::value_helpers<std::span<T>, std::enable_if_t<jnjs::detail::is_typed_array_element_v<T>>> {
+    using E = std::remove_const_t<T>;
+
+    static bool is(JSContext *, JSValue v) { return is_viewable_as<E>(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static std::span<T> as(JSContext *c, JSValue v) {
+        if (JS_GetTypedArrayType(v) < 0) {
+            if constexpr (sizeof(E) == 1) {
+                size_t size = 0;
+                auto *p = JS_GetArrayBuffer(c, &size, v);
+                if (p == nullptr) {
+                    JS_FreeValue(c, JS_GetException(c));
+                    return {};
+                }
+                return {reinterpret_cast<T *>(p), size};
+            }
+            return {};
+        }
+        size_t offset = 0, length = 0, bpe = 0;
+        auto buf = JS_GetTypedArrayBuffer(c, v, &offset, &length, &bpe);
+        if (JS_IsException(buf)) {
+            JS_FreeValue(c, JS_GetException(c));
+            return {};
+        }
+        size_t size = 0;
+        auto *p = JS_GetArrayBuffer(c, &size, buf);
+        // the TypedArray keeps its buffer alive
+        JS_FreeValue(c, buf);
+        if (p == nullptr) {
+            JS_FreeValue(c, JS_GetException(c));
+            return {};
+        }
+        return {reinterpret_cast<T *>(p + offset), length / sizeof(E)};
+    }
+    static JSValue from(JSContext *c, const std::span<T> &v) {
+        auto buf = JS_NewArrayBufferCopy(c, reinterpret_cast<const uint8_t *>(v.data()), v.size_bytes());
+        if (JS_IsException(buf))
+            return buf;
+        auto ret = JS_NewTypedArray(c, 1, &buf, static_cast<JSTypedArrayEnum>(typed_array_kind_v<E>));
+        JS_FreeValue(c, buf);
+        return ret;
+    }
+};
+
+template <> struct jnjs::detail::value_helpers<jnjs::external_buffer> {
+    static bool is(JSContext *, JSValue v) { return JS_IsArrayBuffer(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static JSValue from(JSContext *c, const external_buffer &v) {
+        auto *owner = new std::shared_ptr<void>(v._owner);
+        auto ret = JS_NewArrayBuffer(c, static_cast<uint8_t *>(v._data), v._size, release, owner, false);
+        if (JS_IsException(ret))
+            delete owner;
+        return ret;
+    }
+
+  private:
+    static void release(JSRuntime *, void *opaque, void *) { delete static_cast<std::shared_ptr<void> *>(opaque); }
+};
@@ -1,25 +1,183 @@
 #pragma once
 
 #include <quickjs.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 
 #include "../fwd.h"
+#include "../hedley.h"
+
+namespace jnjs {
+/**
+ * @brief A string encoded as ISO-8859-1, converted to JS without UTF-8 decoding.
+ */
+struct latin1_view {
+    std::string_view str;
+};
+
+namespace detail {
+/**
+ * @internal
+ * @brief Format integral numbers the way JS does, without going through a JS string.
+ * @param v A number value.
+ * @param out Set to the formatted number.
+ * @return If `v` was integral and formatted, false if the general conversion is needed.
+ */
+inline bool integral_to_string(JSValue v, std::string &out) {
+    char buf[24];
+    std::to_chars_result r;
+    const auto tag = JS_VALUE_GET_TAG(v);
+    if (tag == JS_TAG_INT) {
+        r = std::to_chars(buf, buf + sizeof(buf), JS_VALUE_GET_INT(v));
+    } else if (JS_TAG_IS_FLOAT64(tag)) {
+        // doubles in the safe integer range print like integers, -0 included
+        const double d = JS_VALUE_GET_FLOAT64(v);
+        if (!(std::fabs(d) <= 9007199254740991.0) || std::trunc(d) != d)
+            return false;
+        r = std::to_chars(buf, buf + sizeof(buf), static_cast<int64_t>(d));
+    } else {
+        return false;
+    }
+    out.assign(buf, r.ptr);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Append UTF-8 text to a UTF-16 string.
+ * @note Invalid sequences become U+FFFD.
+ */
+inline void utf8_to_utf16(std::string_view in, std::u16string &out) {
+    out.reserve(out.size() + in.size());
+    const auto *p = reinterpret_cast<const uint8_t *>(in.data());
+    const auto *end = p + in.size();
+    while (p < end) {
+        uint32_t c = *p++;
+        if (HEDLEY_LIKELY(c < 0x80)) {
+            out.push_back(static_cast<char16_t>(c));
+            continue;
+        }
+        const int extra = c >= 0xf8 ? -1 : c >= 0xf0 ? 3 : c >= 0xe0 ? 2 : c >= 0xc0 ? 1 : -1;
+        bool ok = extra > 0 && end - p >= extra;
+        for (int i = 0; ok && i < extra; ++i) {
+            ok = (p[i] & 0xc0) == 0x80;
+        }
+        if (!ok) {
+            out.push_back(u'\ufffd');
+            continue;
+        }
+        c &= 0x3f >> extra;
+        for (int i = 0; i < extra; ++i) {
+            c = (c << 6) | (*p++ & 0x3f);
+        }
+        if (c >= 0x10000) {
+            c -= 0x10000;
+            out.push_back(static_cast<char16_t>(0xd800 | (c >> 10)));
+            out.push_back(static_cast<char16_t>(0xdc00 | (c & 0x3ff)));
+        } else {
+            out.push_back(static_cast<char16_t>(c));
+        }
+    }
+}
+} // namespace detail
+} // namespace jnjs
 
 template <> struct jnjs::detail::value_helpers<std::string> {
     static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
     static bool is_convertible(JSContext *, JSValue) { return true; }
     static std::string as(JSContext *c, JSValue v) {
-        auto s = JS_ToCString(c, v);
+        std::string ret;
+        if (integral_to_string(v, ret))
+            return ret;
+        size_t len = 0;
+        auto s = JS_ToCStringLen(c, &len, v);
         if (s == nullptr && JS_IsException(v)) {
             auto e = JS_GetException(c);
-            s = JS_ToCString(c, e);
+            s = JS_ToCStringLen(c, &len, e);
             JS_FreeValue(c, e);
         }
-        std::string ret(s ? s : "<error>");
-        if (s)
+        if (s) {
+            ret.assign(s, len);
+            JS_FreeCString(c, s);
+        } else {
+            ret = "<error>";
+        }
+        return ret;
+    }
+    static JSValue from(JSContext *c, const std::string &v) { return JS_NewStringLen(c, v.data(), v.size()); }
+};
+
+/**
+ * @note Lone surrogates in the JS string are not preserved.
+ */
+template <> struct jnjs::detail::value_helpers<std::u16string> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static std::u16string as(JSContext *c, JSValue v) {
+        std::u16string ret;
+        size_t len = 0;
+        auto s = JS_ToCStringLen(c, &len, v);
+        if (s) {
+            utf8_to_utf16({s, len}, ret);
             JS_FreeCString(c, s);
+        }
         return ret;
     }
-    static JSValue from(JSContext *c, const std::string &v) { return JS_NewString(c, v.c_str()); }
+    static JSValue from(JSContext *c, const std::u16string &v) {
+        return JS_NewTwoByteString(c, reinterpret_cast<const uint16_t *>(v.data()), v.size());
+    }
+};
+
+template <> struct jnjs::detail::value_helpers<std::u16string_view> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static JSValue from(JSContext *c, const std::u16string_view &v) {
+        return JS_NewTwoByteString(c, reinterpret_cast<const uint16_t *>(v.data()), v.size());
+    }
 };
 
+/**
+ * @note QuickJS has no public constructor for one byte strings. ASCII is passed through as is. Anything else is
+ * encoded as UTF-8 in a single pass, which QuickJS decodes back into a one byte per character string, never UTF-16.
+ */
+template <> struct jnjs::detail::value_helpers<jnjs::latin1_view> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static JSValue from(JSContext *c, const latin1_view &v) {
+        const auto *p = reinterpret_cast<const uint8_t *>(v.str.data());
+        const auto n = v.str.size();
+        // skip the ASCII prefix 8 bytes at a time, it is copied as is
+        size_t i = 0;
+        for (uint64_t w; i + 8 <= n; i += 8) {
+            std::memcpy(&w, p + i, sizeof(w));
+            if (w & 0x8080808080808080ULL)
+                break;
+        }
+        while (i < n && p[i] < 0x80) {
+            ++i;
+        }
+        if (HEDLEY_LIKELY(i == n))
+            return JS_NewStringLen(c, v.str.data(), n);
+
+        // every byte from the first non-ASCII one on takes at most two bytes of UTF-8
+        std::string utf8(i + (n - i) * 2, '\0');
+        auto *o = reinterpret_cast<uint8_t *>(utf8.data());
+        std::memcpy(o, p, i);
+        o += i;
+        for (; i < n; ++i) {
+            const auto ch = p[i];
+            if (ch < 0x80) {
+                *o++ = ch;
+            } else {
+                *o++ = static_cast<uint8_t>(0xc0 | (ch >> 6));
+                *o++ = static_cast<uint8_t>(0x80 | (ch & 0x3f));
+            }
+        }
+        return JS_NewStringLen(c, utf8.data(), static_cast<size_t>(o - reinterpret_cast<uint8_t *>(utf8.data())));
+    }
+};
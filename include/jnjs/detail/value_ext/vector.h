@@ -2,32 +2,132 @@
 
 #include <quickjs.h>
 
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 #include "../fwd.h"
+#include "../hedley.h"
+#include "../simd.h"
+#include "./span.h"
 
+namespace jnjs {
+/**
+ * @brief A vector that converts to and from a JS TypedArray with a single copy.
+ * @tparam T Arithmetic element type with a matching TypedArray, e.g. `float` for Float32Array.
+ * @note Plain JS arrays are accepted as well, converting each element.
+ */
+template <typename T> struct typed_array final : std::vector<T> {
+    static_assert(detail::typed_array_kind_v<T> != -1 && !std::is_same_v<T, std::byte>,
+        "typed_array needs an element type with a matching TypedArray");
+    using std::vector<T>::vector;
+};
+} // namespace jnjs
+
+namespace jnjs::detail {
+/**
+ * @internal
+ * @brief Copy a TypedArray into a vector if its elements are exactly `T`.
+ * @return If `v` was such a TypedArray.
+ */
+template <typename T, typename A> bool copy_typed_array(JSContext *c, JSValue v, std::vector<T, A> &out) {
+    if constexpr (typed_array_kind_v<T> != -1 && !std::is_same_v<T, std::byte>) {
+        if (JS_GetTypedArrayType(v) != typed_array_kind_v<T>)
+            return false;
+        const auto s = value_helpers<std::span<const T>>::as(c, v);
+        out.assign(s.begin(), s.end());
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/**
+ * @internal
+ * @brief Convert the elements of a JS array one by one.
+ */
+template <typename T, typename A> void copy_array(JSContext *c, JSValue v, std::vector<T, A> &out) {
+    int64_t len;
+    if (JS_GetLength(c, v, &len) < 0 || len < 0) {
+        return;
+    }
+    out.reserve(static_cast<size_t>(len));
+    for (int64_t i = 0; i < len; ++i) {
+        // dense arrays take QuickJS' fast array path for integer indices below 2^32
+        auto val = len <= UINT32_MAX ? JS_GetPropertyUint32(c, v, static_cast<uint32_t>(i))
+                                     : JS_GetPropertyInt64(c, v, i);
+        out.push_back(value_helpers<T>::as(c, val));
+        JS_FreeValue(c, val);
+    }
+}
+
+/**
+ * @internal
+ * @brief Create a JS array from a range, allocating its storage once.
+ */
+template <typename T, typename It> JSValue new_array(JSContext *c, It first, size_t n) {
+    if (HEDLEY_UNLIKELY(n > INT_MAX)) {
+        auto rv = JS_NewArray(c);
+        for (size_t i = 0; i < n; ++i, ++first) {
+            JS_SetPropertyInt64(c, rv, static_cast<int64_t>(i), value_helpers<T>::from(c, *first));
+        }
+        return rv;
+    }
+    std::vector<JSValue> vals;
+    if constexpr (std::contiguous_iterator<It> && std::is_same_v<T, int32_t>) {
+        vals.resize(n);
+        simd::box_int32(std::to_address(first), n, vals.data());
+        return JS_NewArrayFrom(c, static_cast<int>(n), vals.data());
+    } else if constexpr (std::contiguous_iterator<It> && std::is_same_v<T, double>) {
+        vals.resize(n);
+        simd::box_float64(std::to_address(first), n, vals.data());
+        return JS_NewArrayFrom(c, static_cast<int>(n), vals.data());
+    }
+    vals.reserve(n);
+    for (size_t i = 0; i < n; ++i, ++first) {
+        vals.push_back(value_helpers<T>::from(c, *first));
+    }
+    // takes ownership of the values
+    return JS_NewArrayFrom(c, static_cast<int>(n), vals.data());
+}
+} // namespace jnjs::detail
+
+/**
+ * @note Arithmetic elements are also read from TypedArrays of the same element type, in one copy.
+ */
 template <typename T> struct jnjs::detail::value_helpers<std::vector<T>> {
     static bool is(JSContext *, JSValue v) { return JS_IsArray(v); }
-    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static bool is_convertible(JSContext *c, JSValue v) {
+        if constexpr (typed_array_kind_v<T> != -1 && !std::is_same_v<T, std::byte>) {
+            if (JS_GetTypedArrayType(v) == typed_array_kind_v<T>)
+                return true;
+        }
+        return is(c, v);
+    }
     static std::vector<T> as(JSContext *c, JSValue v) {
         std::vector<T> ret;
-        int64_t len;
-        if (JS_GetLength(c, v, &len) < 0 || len < 0) {
-            return ret;
-        }
-        ret.resize(len);
-        for (int64_t i = 0; i < len; ++i) {
-            auto val = JS_GetPropertyInt64(c, v, i);
-            ret.at(i) = std::move(value_helpers<T>::as(c, val));
-            JS_FreeValue(c, val);
-        }
+        if (!copy_typed_array(c, v, ret))
+            copy_array(c, v, ret);
         return ret;
     }
-    static JSValue from(JSContext *c, const std::vector<T> &v) {
-        auto rv = JS_NewArray(c);
-        for (int64_t i = 0; i < v.size(); ++i) {
-            JS_SetPropertyInt64(c, rv, i, value_helpers<T>::from(c, v[i]));
-        }
-        return rv;
+    static JSValue from(JSContext *c, const std::vector<T> &v) { return new_array<T>(c, v.begin(), v.size()); }
+};
+
+template <typename T> struct jnjs::detail::value_helpers<jnjs::typed_array<T>> {
+    static bool is(JSContext *, JSValue v) { return JS_GetTypedArrayType(v) == typed_array_kind_v<T>; }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v) || JS_IsArray(v); }
+    static typed_array<T> as(JSContext *c, JSValue v) {
+        typed_array<T> ret;
+        if (!copy_typed_array(c, v, ret))
+            copy_array(c, v, ret);
+        return ret;
+    }
+    static JSValue from(JSContext *c, const typed_array<T> &v) {
+        return value_helpers<std::span<const T>>::from(c, std::span<const T>(v.data(), v.size()));
     }
-}; // namespace jnjs::detail};
\ No newline at end of file
+};
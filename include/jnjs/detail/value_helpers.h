@@ -2,8 +2,13 @@
 
 #include <quickjs.h>
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
 #include "fwd.h"
 #include "hedley.h"
+#include "runtime_data.h"
 #include "type_traits.h"
 #include "types.h"
 
@@ -85,6 +90,41 @@ template <> struct value_helpers<uint64_t> {
     static JSValue from(JSContext *c, const uint64_t &v) { return JS_NewInt64(c, static_cast<int64_t>(v)); }
 };
 
+/**
+ * @note Reads ints and doubles straight from the tag, and writes integral values as ints like QuickJS itself does.
+ * Only the JS_TAG_IS_FLOAT64 and JS_VALUE_GET_FLOAT64 macros are used, so NaN boxing builds work unchanged.
+ */
+template <> struct value_helpers<double> {
+    static bool is(JSContext *, const JSValue v) { return JS_IsNumber(v); }
+    constexpr static bool is_convertible(JSContext *, JSValue) { return true; }
+    static double as(JSContext *c, const JSValue v) {
+        const auto tag = JS_VALUE_GET_TAG(v);
+        if (HEDLEY_LIKELY(JS_TAG_IS_FLOAT64(tag)))
+            return JS_VALUE_GET_FLOAT64(v);
+        if (JS_IS_IN_INT32(v))
+            return tag == JS_TAG_UNDEFINED ? std::numeric_limits<double>::quiet_NaN() : JS_VALUE_GET_INT(v);
+        double ret = std::numeric_limits<double>::quiet_NaN();
+        JS_ToFloat64(c, &ret, v);
+        return ret;
+    }
+    static JSValue from(JSContext *c, const double &v) {
+        // NaN fails the range check, -0 has to stay a double
+        if (v >= INT32_MIN && v <= INT32_MAX) {
+            const auto i = static_cast<int32_t>(v);
+            if (i == v && (i != 0 || !std::signbit(v)))
+                return JS_MKVAL(JS_TAG_INT, i);
+        }
+        return JS_NewFloat64(c, v);
+    }
+};
+
+template <> struct value_helpers<float> {
+    static bool is(JSContext *c, const JSValue v) { return value_helpers<double>::is(c, v); }
+    constexpr static bool is_convertible(JSContext *, JSValue) { return true; }
+    static float as(JSContext *c, const JSValue v) { return static_cast<float>(value_helpers<double>::as(c, v)); }
+    static JSValue from(JSContext *c, const float &v) { return value_helpers<double>::from(c, v); }
+};
+
 template <> struct value_helpers<JSValue> { // lol
     static bool is(JSContext *, JSValue) { return true; }
     static bool is_convertible(JSContext *, JSValue) { return true; }
@@ -93,13 +133,11 @@ template <> struct value_helpers<JSValue> { // lol
 };
 
 template <typename T> struct value_helpers<T *, std::enable_if_t<has_build_v<T>>> {
-    static bool is(JSContext *, const JSValue v) { return JS_GetClassID(v) == internal_class_meta<T>::data.id; }
+    static bool is(JSContext *c, const JSValue v) { return JS_GetClassID(v) == class_id<T>(c); }
     static bool is_convertible(JSContext *c, const JSValue v) { return is(c, v); }
-    static T *as(JSContext *, const JSValue v) {
-        return static_cast<T *>(JS_GetOpaque(v, internal_class_meta<T>::data.id));
-    }
+    static T *as(JSContext *c, const JSValue v) { return static_cast<T *>(JS_GetOpaque(v, class_id<T>(c))); }
     static JSValue from(JSContext *c, T *v) {
-        auto ret = JS_NewObjectClass(c, internal_class_meta<T>::data.id);
+        auto ret = JS_NewObjectClass(c, class_id<T>(c));
         JS_SetOpaque(ret, v);
         return ret;
     }
@@ -0,0 +1,41 @@
+#pragma once
+/**
+ * @file error.h
+ * @brief C++ representation of JavaScript errors.
+ */
+
+#include <stdexcept>
+
+#include <quickjs.h>
+
+#include "detail/fwd.h"
+
+namespace jnjs {
+
+/**
+ * @brief A JavaScript exception, surfaced to C++.
+ *
+ * Any value returned from an evaluation or call that threw can be converted into one with `as<js_error>()`, which
+ * takes the pending exception out of the context.
+ */
+class js_error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+template <> struct detail::value_helpers<js_error> {
+    static bool is(JSContext *, JSValue v) { return JS_IsException(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v) || JS_IsError(c, v); }
+    static js_error as(JSContext *c, JSValue v) {
+        auto e = JS_IsException(v) ? JS_GetException(c) : JS_DupValue(c, v);
+        auto s = JS_ToCString(c, e);
+        js_error ret(s ? s : "<error>");
+        if (s)
+            JS_FreeCString(c, s);
+        JS_FreeValue(c, e);
+        return ret;
+    }
+    static JSValue from(JSContext *c, const js_error &v) { return JS_ThrowInternalError(c, "%s", v.what()); }
+};
+
+} // namespace jnjs
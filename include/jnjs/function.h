@@ -52,6 +52,7 @@ class function {
      * @return Return value of the function.
      */
     value _invoke_impl(JSValue *v, int c) const {
+        const detail::run_scope running(_v._ctx);
         const auto r = JS_Call(_v._ctx, _v._v, _this._v, c, v);
         return value(r, _v._ctx);
     }
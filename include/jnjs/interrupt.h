@@ -0,0 +1,171 @@
+#pragma once
+/**
+ * @file interrupt.h
+ * @brief Deadlines, instruction budgets and cross-thread termination of running scripts.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <quickjs.h>
+
+#include "error.h"
+
+#include "detail/fwd.h"
+#include "detail/runtime_data.h"
+#include "detail/types.h"
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief A script was stopped by an execution_limit or a terminate_handle.
+ */
+class interrupted_error : public js_error {
+  public:
+    explicit interrupted_error(interrupt_reason r) : js_error("interrupted"), _reason(r) {}
+
+    /**
+     * @brief Get why the script was stopped.
+     * @return The interrupt reason.
+     */
+    [[nodiscard]] interrupt_reason reason() const { return _reason; }
+
+  private:
+    interrupt_reason _reason;
+};
+
+/**
+ * @brief Limits on how long scripts may run.
+ */
+struct limits {
+    /** Wall clock time scripts may run for. */
+    std::optional<std::chrono::steady_clock::duration> timeout = std::nullopt;
+    /**
+     * Number of interrupt checks scripts may run for. QuickJS checks roughly every 10000 function calls and
+     * backwards jumps, so this is a coarse, clock independent instruction budget.
+     */
+    std::optional<uint64_t> budget = std::nullopt;
+};
+
+/**
+ * @brief Thread-safe handle to stop the script running in a runtime.
+ *
+ * Handles can be copied to and used from any thread, and stay valid after the runtime is destroyed. Termination
+ * applies to the outermost evaluation or call in progress, e.g. a whole pool job's eval, including the C++ functions
+ * it calls back into.
+ */
+class terminate_handle {
+  public:
+    terminate_handle() = default;
+
+    /**
+     * @brief Interrupt the script currently running in the runtime.
+     * @note A request made while the runtime is idle, or that the script finishes before acting on, is dropped when
+     * the next evaluation or call starts, so it never stops an unrelated script.
+     */
+    void terminate() const noexcept {
+        if (_flag)
+            _flag->store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Cancel a termination request that has not been acted on yet.
+     */
+    void reset() const noexcept {
+        if (_flag)
+            _flag->store(false, std::memory_order_relaxed);
+    }
+
+  private:
+    explicit terminate_handle(std::shared_ptr<std::atomic<bool>> f) : _flag(std::move(f)) {}
+
+    std::shared_ptr<std::atomic<bool>> _flag;
+    friend runtime;
+};
+
+/**
+ * @brief Scoped limit on every evaluation and call made through a runtime.
+ *
+ * While an execution_limit is alive, any script running in its runtime is interrupted once the limit is exceeded,
+ * which makes the evaluation or call return an exception. Check reason() afterwards to tell a timeout apart from an
+ * error thrown by the script, or convert the result with `as<interrupted_error>()`. Limits nest, an inner limit can
+ * only tighten the ones around it.
+ *
+ * @code
+ * jnjs::execution_limit limit(ctx, {.timeout = std::chrono::milliseconds(50)});
+ * auto r = ctx.eval(code);
+ * if (limit.reason() == jnjs::interrupt_reason::deadline) { ... }
+ * @endcode
+ */
+class execution_limit {
+  public:
+    /**
+     * @brief Arm a limit on a context's runtime.
+     * @param ctx Context to limit, affects every context of the same runtime.
+     * @param l Limits to apply.
+     */
+    execution_limit(context &ctx, const limits &l = {});
+    /**
+     * @brief Arm a limit on a runtime.
+     * @param rt Runtime to limit.
+     * @param l Limits to apply.
+     */
+    execution_limit(runtime &rt, const limits &l = {});
+    ~execution_limit() { _d.limit = _f.prev; }
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(execution_limit)
+
+    /**
+     * @brief Get why a script was interrupted while this limit was armed.
+     * @return The interrupt reason, or interrupt_reason::none.
+     */
+    [[nodiscard]] interrupt_reason reason() const { return _f.reason; }
+    /**
+     * @brief Check if a script was interrupted while this limit was armed.
+     * @return If reason() is not interrupt_reason::none.
+     */
+    [[nodiscard]] bool interrupted() const { return _f.reason != interrupt_reason::none; }
+
+  private:
+    execution_limit(JSRuntime *rt, const limits &l) : _d(detail::runtime_data::get(rt)) {
+        if (l.timeout)
+            _f.deadline = std::chrono::steady_clock::now() + *l.timeout;
+        if (l.budget)
+            _f.budget = *l.budget;
+        _f.prev = _d.limit;
+        _d.limit = &_f;
+        _d.last_interrupt = interrupt_reason::none;
+    }
+
+    detail::runtime_data &_d;
+    detail::interrupt_frame _f;
+};
+
+/**
+ * @brief Converts the exception left by an interrupted script.
+ * @note `is` only holds until the exception is taken, the next execution_limit is armed, or the next evaluation or
+ * call starts.
+ */
+template <> struct detail::value_helpers<interrupted_error> {
+    static bool is(JSContext *c, JSValue v) {
+        return JS_IsException(v) && runtime_data::get(c).last_interrupt != interrupt_reason::none;
+    }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static interrupted_error as(JSContext *c, JSValue v) {
+        auto &d = runtime_data::get(c);
+        interrupted_error ret(d.last_interrupt);
+        d.last_interrupt = interrupt_reason::none;
+        if (JS_IsException(v))
+            JS_FreeValue(c, JS_GetException(c));
+        return ret;
+    }
+    static JSValue from(JSContext *c, const interrupted_error &v) {
+        return JS_ThrowInternalError(c, "%s", v.what());
+    }
+};
+
+} // namespace jnjs
@@ -7,9 +7,26 @@
 #include "detail/value_ext/all.h"
 #include "detail/value_helpers.h"
 
+#include "allocator.h"
+#include "array_ref.h"
 #include "binding.h"
+#include "borrowed_value.h"
+#include "bundle.h"
+#include "bytecode_cache.h"
 #include "context.h"
+#include "context_pool.h"
+#include "context_template.h"
+#include "error.h"
 #include "function.h"
+#include "interrupt.h"
+#include "memory.h"
 #include "module.h"
+#include "prop_key.h"
 #include "runtime.h"
-#include "value.h"
\ No newline at end of file
+#include "runtime_pool.h"
+#include "script.h"
+#include "serialized.h"
+#include "string_ref.h"
+#include "value.h"
+#include "value_scope.h"
+#include "views.h"
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+/**
+ * @file memory.h
+ * @brief Memory and GC statistics.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <quickjs.h>
+
+namespace jnjs {
+
+/**
+ * @brief Snapshot of a runtime's memory usage.
+ *
+ * Sizes are in bytes. Contexts share their runtime's heap, so every context of a runtime reports the same numbers.
+ */
+struct memory_stats {
+    int64_t malloc_size = 0;       /**< Bytes currently allocated, including allocator overhead. */
+    int64_t malloc_limit = 0;      /**< Memory limit set on the runtime, or -1 if unlimited. */
+    int64_t malloc_count = 0;      /**< Number of live allocations. */
+    int64_t memory_used_size = 0;  /**< Bytes used by the objects below. */
+    int64_t memory_used_count = 0; /**< Number of allocations used by the objects below. */
+
+    int64_t atom_count = 0;  /**< Number of atoms (interned property names and strings). */
+    int64_t atom_size = 0;   /**< Bytes used by atoms. */
+    int64_t str_count = 0;   /**< Number of strings. */
+    int64_t str_size = 0;    /**< Bytes used by strings. */
+    int64_t obj_count = 0;   /**< Number of objects, a steadily growing count usually means leaked handles. */
+    int64_t obj_size = 0;    /**< Bytes used by objects. */
+    int64_t prop_count = 0;  /**< Number of object properties. */
+    int64_t prop_size = 0;   /**< Bytes used by object properties. */
+    int64_t shape_count = 0; /**< Number of object shapes. */
+    int64_t shape_size = 0;  /**< Bytes used by object shapes. */
+
+    int64_t js_func_count = 0;       /**< Number of JS functions. */
+    int64_t js_func_size = 0;        /**< Bytes used by JS functions. */
+    int64_t js_func_code_size = 0;   /**< Bytes of bytecode. */
+    int64_t c_func_count = 0;        /**< Number of native functions. */
+    int64_t array_count = 0;         /**< Number of arrays. */
+    int64_t fast_array_count = 0;    /**< Number of arrays using dense storage. */
+    int64_t fast_array_elements = 0; /**< Number of elements stored in dense arrays. */
+    int64_t binary_object_count = 0; /**< Number of ArrayBuffers and typed arrays. */
+    int64_t binary_object_size = 0;  /**< Bytes used by ArrayBuffers and typed arrays. */
+
+    /**
+     * Number of collections run through runtime::run_gc.
+     * @note Automatic collections triggered by gc_threshold are not counted, QuickJS does not report them.
+     */
+    uint64_t explicit_gc_runs = 0;
+    size_t gc_threshold = 0; /**< Allocated bytes at which QuickJS runs the next automatic collection. */
+};
+
+namespace detail {
+/**
+ * @internal
+ * @brief Collect memory statistics for a runtime.
+ * @note Walks the whole heap, so the cost grows with the number of live objects.
+ * @param rt Runtime created by jnjs::runtime.
+ * @return Current statistics.
+ */
+memory_stats compute_memory_stats(JSRuntime *rt);
+} // namespace detail
+
+} // namespace jnjs
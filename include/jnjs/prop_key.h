@@ -0,0 +1,117 @@
+#pragma once
+/**
+ * @file prop_key.h
+ * @brief Property names atomized once per runtime.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <quickjs.h>
+
+#include "detail/hedley.h"
+#include "detail/runtime_data.h"
+#include "detail/util.h"
+
+namespace jnjs {
+
+namespace detail {
+/**
+ * @internal
+ * @brief Allocate a process-wide index for a property key.
+ * @return A new key index, unique for the lifetime of the process.
+ */
+inline uint32_t next_key_index() {
+    static std::atomic<uint32_t> counter = 0;
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @internal
+ * @brief String literal usable as a template argument.
+ * @tparam N Size of the literal, including the null terminator.
+ */
+template <size_t N> struct fixed_string {
+    constexpr fixed_string(const char (&s)[N]) { std::copy_n(s, N, value); } // NOLINT(google-explicit-constructor)
+    [[nodiscard]] constexpr std::string_view view() const { return {value, N - 1}; }
+    char value[N] = {};
+};
+} // namespace detail
+
+/**
+ * @brief A property name, converted to a QuickJS atom once per runtime and cached.
+ *
+ * Looking a property up by `const char *` converts the name to an atom on every access. A prop_key does that the
+ * first time it is used in a runtime, and reuses the atom from then on. Keys are meant to be long lived, e.g. static
+ * or namespace scope variables, since every key ever created takes a slot in each runtime's cache. For names known at
+ * compile time, use jnjs::key.
+ *
+ * @code
+ * static const jnjs::prop_key price("price");
+ * for (auto &item : items) total += item[price].as<int>();
+ * @endcode
+ */
+class prop_key {
+  public:
+    /**
+     * @brief Create a key.
+     * @param name Name of the property, not copied, so it must outlive the key.
+     */
+    constexpr explicit prop_key(std::string_view name) : _name(name) {}
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(prop_key)
+
+    /**
+     * @brief Get the property name.
+     * @return Name of the property.
+     */
+    [[nodiscard]] constexpr std::string_view name() const { return _name; }
+
+    /**
+     * @internal
+     * @brief Get the atom for this key in a context's runtime, creating it on first use.
+     * @param ctx JS context.
+     * @return The atom, owned by the runtime's cache.
+     * @throws std::bad_alloc if the runtime's key cache can not grow to hold a key used for the first time.
+     */
+    HEDLEY_NON_NULL(2)
+    [[nodiscard]] JSAtom atom(JSContext *ctx) const {
+        auto &atoms = detail::runtime_data::get(ctx).atoms;
+        const auto i = _index();
+        if (HEDLEY_LIKELY(i < atoms.size() && atoms[i] != JS_ATOM_NULL))
+            return atoms[i];
+        if (atoms.size() <= i)
+            atoms.resize(i + 1, JS_ATOM_NULL);
+        atoms[i] = JS_NewAtomLen(ctx, _name.data(), _name.size());
+        return atoms[i];
+    }
+
+  private:
+    // indices are allocated on first use, so keys can be constant initialized
+    [[nodiscard]] uint32_t _index() const {
+        auto i = _slot.load(std::memory_order_relaxed);
+        if (HEDLEY_UNLIKELY(i == 0)) {
+            const auto n = detail::next_key_index() + 1;
+            i = _slot.compare_exchange_strong(i, n, std::memory_order_relaxed) ? n : i;
+        }
+        return i - 1;
+    }
+
+    std::string_view _name;
+    mutable std::atomic<uint32_t> _slot = 0; /**< Key index + 1, or 0 before first use. */
+};
+
+/**
+ * @brief Property key for a name known at compile time.
+ * @tparam S Name of the property.
+ *
+ * @code
+ * auto id = obj[jnjs::key<"id">].as<int>();
+ * @endcode
+ */
+template <detail::fixed_string S> inline constinit const prop_key key{S.view()};
+
+} // namespace jnjs
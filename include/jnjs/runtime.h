@@ -6,7 +6,11 @@
 
 #include <memory>
 
+#include "allocator.h"
+#include "bundle.h"
 #include "context.h"
+#include "interrupt.h"
+#include "memory.h"
 
 #include "detail/util.h"
 
@@ -14,32 +18,92 @@ namespace jnjs {
 
 /**
  * @brief JS runtime instance.
- * @note Only one runtime can ever exist during the applications lifecycle.
+ *
+ * Runtimes are fully independent of each other, so any number of them can exist at once, e.g. one per worker thread.
+ * @warning A runtime is not thread-safe: it and every context created from it must only be used by one thread at a
+ * time, and all of its contexts must be destroyed before the runtime is.
  */
 class runtime : detail::impl_ptr<JSRuntime> {
     using base = detail::impl_ptr<JSRuntime>;
 
   public:
     /**
-     * @brief Get the singleton instance of the JS runtime.
-     * @return Singleton instance of the JS runtime.
+     * @brief Create a new runtime using the system allocator.
+     */
+    runtime();
+    /**
+     * @brief Create a new runtime using a custom allocator.
+     * @param alloc Allocator for all of the runtime's memory, or nullptr for the system allocator.
+     */
+    explicit runtime(std::unique_ptr<allocator> alloc);
+    ~runtime() = default;
+
+    JNJS_IMPL_NON_COPYABLE(runtime)
+    runtime(runtime &&) noexcept = default;
+    runtime &operator=(runtime &&) noexcept = default;
+
+    /**
+     * @brief Get the default, process-wide JS runtime.
+     * @note The default runtime is created on first use, and is only safe to use from one thread at a time.
+     * @return Default instance of the JS runtime.
      */
     static runtime &instance() {
         static runtime instance;
         return instance;
     }
 
+    /**
+     * @brief Create a new js context using the default runtime.
+     * @return New JS context using the default runtime.
+     */
+    static context new_context() { return instance().make_context(); }
+
     /**
      * @brief Create a new js context.
      * @return New JS context using this runtime.
      */
-    static context new_context() { return instance()._new_context(); }
+    context make_context();
 
-  private:
-    runtime();            /**< @internal Create a new runtime. */
-    ~runtime() = default; /**< @internal Destroy the runtime. */
+    /**
+     * @brief Get a handle that can stop this runtime's scripts from another thread.
+     * @return Termination handle for this runtime.
+     */
+    [[nodiscard]] terminate_handle terminator() const {
+        return terminate_handle(detail::runtime_data::get(get()).terminate);
+    }
 
-    context _new_context(); /**< @internal Create a new JS context using this runtime. */
+    /**
+     * @brief Collect memory and GC statistics.
+     * @note This walks the whole heap, which is fine to do every few seconds but not on every request.
+     * @return Current memory statistics.
+     */
+    [[nodiscard]] memory_stats memory_usage() const { return detail::compute_memory_stats(get()); }
+
+    /**
+     * @brief Run a full garbage collection cycle.
+     */
+    void run_gc();
+
+    /**
+     * @brief Set the allocated size at which the next automatic garbage collection runs.
+     * @param threshold Threshold in bytes.
+     */
+    void set_gc_threshold(size_t threshold) { JS_SetGCThreshold(get(), threshold); }
+
+    /**
+     * @brief Limit the memory a runtime can allocate, allocations past the limit throw out of memory errors.
+     * @param limit Limit in bytes, or 0 for no limit.
+     */
+    void set_memory_limit(size_t limit) { JS_SetMemoryLimit(get(), limit); }
+
+    /**
+     * @brief Load modules imported by this runtime's scripts from a bundle.
+     * @param b Bundle to load modules from, or nullptr to detach the current one.
+     */
+    void set_bundle(std::shared_ptr<const bundle> b);
+
+  private:
+    friend execution_limit;
 };
 
-} // namespace jnjs
\ No newline at end of file
+} // namespace jnjs
@@ -0,0 +1,242 @@
+#pragma once
+/**
+ * @file runtime_pool.h
+ * @brief Pool of runtimes, each owned by a worker thread.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "context.h"
+#include "error.h"
+#include "function.h"
+#include "interrupt.h"
+#include "runtime.h"
+#include "script.h"
+#include "value.h"
+
+#include "detail/util.h"
+
+namespace jnjs {
+
+namespace detail {
+/**
+ * @internal
+ * @brief Convert the result of a pooled job, rethrowing JS exceptions as js_error.
+ * @tparam R Type to convert to.
+ * @param v Result of an evaluation or call.
+ * @return `v` converted to `R`.
+ * @throws interrupted_error if `v` is the exception left by an interrupted script.
+ * @throws js_error if `v` is any other exception.
+ */
+template <typename R> R unwrap_result(const value &v) {
+    if (HEDLEY_UNLIKELY(v.is<js_error>())) {
+        if (v.is<interrupted_error>()) {
+            throw v.as<interrupted_error>();
+        }
+        throw v.as<js_error>();
+    }
+    if constexpr (!std::is_void_v<R>) {
+        return v.as<R>();
+    }
+}
+} // namespace detail
+
+/**
+ * @brief A fixed set of worker threads, each owning its own runtime and context.
+ *
+ * Jobs are queued on a per-worker deque; idle workers steal from the back of their siblings' queues, so long running
+ * scripts on one worker do not hold up the rest of the pool. Results are returned through `std::future`s, and must be
+ * converted to C++ types on the worker, since a jnjs::value can not leave the context it was created in.
+ *
+ * A job submitted from inside another job of the same pool runs inline on the submitting worker, so waiting on its
+ * future can never deadlock.
+ */
+class runtime_pool {
+  public:
+    /**
+     * @brief Function run on each worker's context before it accepts jobs, e.g. to install classes and globals.
+     */
+    using init_fn = std::function<void(context &)>;
+    /**
+     * @brief Function creating the allocator for each worker's runtime.
+     */
+    using allocator_fn = std::function<std::unique_ptr<allocator>()>;
+
+    /**
+     * @brief A script compiled on each worker the first time it runs there, created with compile().
+     */
+    class pooled_script {
+      public:
+        // Create an empty script, which can not be run.
+        pooled_script() = default;
+
+        /**
+         * @brief Check if the script holds code.
+         * @return If the script can be run.
+         */
+        [[nodiscard]] bool valid() const { return _source != nullptr; }
+
+      private:
+        struct source {
+            size_t id;
+            std::string code;
+            std::string filename;
+        };
+        explicit pooled_script(std::shared_ptr<const source> s) : _source(std::move(s)) {}
+
+        std::shared_ptr<const source> _source;
+        friend runtime_pool;
+    };
+
+    /**
+     * @brief Start a new pool.
+     * @param threads Number of worker threads, defaults to the number of hardware threads.
+     * @param init Function run once on each worker's context before it accepts jobs.
+     * @param alloc Function called on each worker to create its runtime's allocator, the system allocator is used if
+     * empty.
+     * @throws The first exception thrown by `init` on any worker, after stopping every worker.
+     */
+    explicit runtime_pool(size_t threads = 0, init_fn init = {}, allocator_fn alloc = {});
+    /**
+     * @brief Finish every queued job, then stop the workers.
+     */
+    ~runtime_pool();
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(runtime_pool)
+
+    /**
+     * @brief Queue a job to run on any worker.
+     * @tparam F Callable taking a `context &`.
+     * @param f Job to run.
+     * @return Future for the job's return value, or the exception it threw.
+     */
+    template <typename F, typename R = std::invoke_result_t<F &, context &>> std::future<R> submit(F &&f) {
+        static_assert(!std::is_same_v<R, value>, "values are bound to the worker's context, convert them first");
+        auto fn = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
+        auto p = std::make_shared<std::promise<R>>();
+        auto ret = p->get_future();
+        _push([fn, p](context &ctx) {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    (*fn)(ctx);
+                    p->set_value();
+                } else {
+                    p->set_value((*fn)(ctx));
+                }
+            } catch (...) {
+                p->set_exception(std::current_exception());
+            }
+        });
+        return ret;
+    }
+
+    /**
+     * @brief Call a global JS function on any worker.
+     * @tparam R Type to convert the return value to.
+     * @tparam Args Types of the arguments.
+     * @param name Name of the global function.
+     * @param args Arguments to pass to the function.
+     * @return Future for the converted return value.
+     * @throws js_error (through the future) if the call throws.
+     */
+    template <typename R, typename... Args> std::future<R> call(std::string name, Args... args) {
+        return submit([name = std::move(name), args = std::make_tuple(std::move(args)...)](context &ctx) -> R {
+            auto fn = ctx.get_global(name.c_str()).template as<function>();
+            auto r = std::apply([&fn](const Args &...a) { return fn(a...); }, args);
+            return detail::unwrap_result<R>(r);
+        });
+    }
+
+    /**
+     * @brief Evaluate a script on any worker.
+     * @tparam R Type to convert the completion value to.
+     * @param code Code to evaluate.
+     * @return Future for the converted completion value.
+     * @throws js_error (through the future) if evaluation throws.
+     */
+    template <typename R = undefined> std::future<R> eval(std::string code) {
+        return submit([code = std::move(code)](context &ctx) -> R {
+            return detail::unwrap_result<R>(ctx.eval(code));
+        });
+    }
+
+    /**
+     * @brief Prepare a script to run on the pool's workers.
+     * @note Each worker compiles the script the first time it runs it, and drops its copy some time after the last
+     * handle to the script is destroyed. Parse errors surface through the futures returned by run().
+     * @param code Code of the script.
+     * @param filename Name of the script in stack traces.
+     * @return Handle to run the script with.
+     */
+    pooled_script compile(std::string code, std::string filename = "<pool>");
+
+    /**
+     * @brief Run a compiled script on any worker.
+     *
+     * Without arguments, the script's completion value is the result. With arguments, the completion value must be a
+     * function, which is called with them:
+     * @code
+     * auto add = pool.compile("(a, b) => a + b");
+     * auto f = pool.run<int>(add, 20, 22);
+     * @endcode
+     *
+     * @tparam R Type to convert the result to.
+     * @tparam Args Types of the arguments.
+     * @param s Script created by this pool's compile().
+     * @param args Arguments to call the completion value with.
+     * @return Future for the converted result.
+     * @throws js_error (through the future) if the script fails to parse or throws.
+     */
+    template <typename R = undefined, typename... Args> std::future<R> run(pooled_script s, Args... args) {
+        return submit([s = std::move(s), args = std::make_tuple(std::move(args)...)](context &ctx) -> R {
+            auto r = _script_for(ctx, s).run();
+            if constexpr (sizeof...(Args) > 0) {
+                auto fn = detail::unwrap_result<function>(r);
+                auto cr = std::apply([&fn](const Args &...a) { return fn(a...); }, args);
+                return detail::unwrap_result<R>(cr);
+            } else {
+                return detail::unwrap_result<R>(r);
+            }
+        });
+    }
+
+    /**
+     * @brief Get the number of workers.
+     * @return Number of worker threads in the pool.
+     */
+    [[nodiscard]] size_t size() const { return _workers.size(); }
+
+  private:
+    /** Runs a job on a worker's context. */
+    using job = std::function<void(context &)>;
+    struct worker;
+
+    static const script &_script_for(context &ctx, const pooled_script &s);
+    void _push(job j);
+    bool _pop(worker &w, job &out);
+    bool _steal(const worker &w, job &out);
+    void _run(worker &w);
+    void _shutdown();
+
+    init_fn _init;
+    allocator_fn _alloc;
+    std::vector<std::unique_ptr<worker>> _workers;
+    std::atomic<size_t> _next = 0;
+    std::atomic<size_t> _pending = 0;
+    std::atomic<size_t> _next_script = 1;
+    std::mutex _sleep_m;
+    std::condition_variable _wake;
+    bool _stop = false;
+};
+
+} // namespace jnjs
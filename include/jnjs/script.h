@@ -0,0 +1,54 @@
+#pragma once
+/**
+ * @file script.h
+ * @brief Scripts compiled once and run many times.
+ */
+
+#include <quickjs.h>
+
+#include "value.h"
+
+namespace jnjs {
+
+/**
+ * @brief A parsed script, ready to run in the context it was compiled in.
+ *
+ * Created with context::compile. Running a script only executes its bytecode, the source is not parsed again.
+ * @note Top level `let`, `const` and `class` declarations are created again on every run, which throws a redeclaration
+ * error from the second run on. Scripts meant to be run repeatedly should keep their state in `var`s, properties of
+ * `globalThis` or an enclosing block.
+ */
+class script {
+  public:
+    // Default constructor creates an empty script, which can not be run.
+    script() = default;
+
+    /**
+     * @brief Run the script.
+     * @return Completion value of the script, or an exception.
+     */
+    value run() const {
+        auto *ctx = _fn._ctx;
+        const detail::run_scope running(ctx);
+        return value(JS_EvalFunction(ctx, JS_DupValue(ctx, _fn._v)), ctx);
+    }
+
+    /**
+     * @brief Check if the script holds compiled code.
+     * @return If the script can be run.
+     */
+    [[nodiscard]] bool valid() const { return _fn._ctx != nullptr; }
+
+  private:
+    /**
+     * @internal
+     * @brief Create a script from a compiled function.
+     * @param fn Function bytecode returned from a compile-only evaluation.
+     */
+    explicit script(value fn) : _fn(std::move(fn)) {}
+
+    value _fn = {}; /**< @internal The compiled function bytecode. */
+    friend context;
+};
+
+} // namespace jnjs
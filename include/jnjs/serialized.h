@@ -0,0 +1,92 @@
+#pragma once
+/**
+ * @file serialized.h
+ * @brief Values serialized to move them between contexts, runtimes and threads.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "detail/fwd.h"
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief A value serialized by value::serialize, to be recreated with context::deserialize.
+ *
+ * The binary format is QuickJS' object serialization. It keeps shared and cyclic references within the value, but
+ * can not hold functions or instances of bound classes. A message is not bound to any context or runtime, so it can
+ * be moved to another thread and read there, any number of times.
+ *
+ * SharedArrayBuffers can be passed through instead of copied. The message then keeps the memory alive until it is
+ * destroyed, and every context reading it sees the same memory as the sender.
+ *
+ * @code
+ * auto msg = std::make_shared<jnjs::serialized>(ctx.eval("({a: [1, 2]})").serialize());
+ * auto f = pool.submit([msg](jnjs::context &other) { return other.deserialize(*msg)["a"][1].as<int>(); });
+ * @endcode
+ */
+class serialized {
+  public:
+    // Create an empty message, which deserializes to undefined.
+    serialized() = default;
+    ~serialized() { _release(); }
+
+    serialized(serialized &&o) noexcept : _data(std::move(o._data)), _sabs(std::move(o._sabs)) { o._sabs.clear(); }
+    serialized &operator=(serialized &&o) noexcept {
+        if (this != &o) {
+            _release();
+            _data = std::move(o._data);
+            _sabs = std::move(o._sabs);
+            o._sabs.clear();
+        }
+        return *this;
+    }
+    JNJS_IMPL_NON_COPYABLE(serialized)
+
+    /**
+     * @brief Get the serialized bytes.
+     * @note Bytes of a message passing SharedArrayBuffers through are only meaningful while the message is alive, and
+     * only within this process.
+     * @return Pointer to size() bytes.
+     */
+    [[nodiscard]] const uint8_t *data() const { return _data.data(); }
+    [[nodiscard]] size_t size() const { return _data.size(); }
+    [[nodiscard]] bool empty() const { return _data.empty(); }
+    /**
+     * @brief Get the number of SharedArrayBuffers passed through.
+     * @return Number of buffers the message keeps alive.
+     */
+    [[nodiscard]] size_t shared_buffers() const { return _sabs.size(); }
+
+    /**
+     * @brief Empty the message, keeping its buffer for reuse.
+     */
+    void clear() {
+        _release();
+        _data.clear();
+    }
+
+  private:
+    void _release() noexcept;
+
+    std::vector<uint8_t> _data;
+    std::vector<uint8_t *> _sabs;
+    friend context;
+    friend value;
+};
+
+namespace detail {
+/**
+ * @internal
+ * @brief QuickJS SharedArrayBuffer functions allocating reference counted memory, shared by every runtime.
+ * @return SharedArrayBuffer functions for JS_SetSharedArrayBufferFunctions.
+ */
+const JSSharedArrayBufferFunctions &shared_buffer_functions();
+} // namespace detail
+
+} // namespace jnjs
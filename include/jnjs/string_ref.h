@@ -0,0 +1,121 @@
+#pragma once
+/**
+ * @file string_ref.h
+ * @brief Borrowed UTF-8 view of a JavaScript string.
+ */
+
+#include <string_view>
+
+#include <quickjs.h>
+
+#include "detail/fwd.h"
+#include "detail/hedley.h"
+#include "detail/util.h"
+
+namespace jnjs {
+
+/**
+ * @brief UTF-8 contents of a JavaScript value converted to a string, held without copying.
+ *
+ * Owns the C string returned by JS_ToCStringLen and releases it on destruction. For pure ASCII strings QuickJS can
+ * hand out its own storage, so no allocation happens at all. Bound functions can take `std::string_view` or
+ * `const char *` arguments, which are backed by a string_ref for the duration of the call.
+ *
+ * @code
+ * auto s = v.as<jnjs::string_ref>();
+ * std::string_view view = s; // valid as long as `s` is
+ * @endcode
+ */
+class string_ref {
+  public:
+    // Create an empty string.
+    string_ref() = default;
+    ~string_ref() {
+        if (_s != nullptr)
+            JS_FreeCString(_ctx, _s);
+    }
+
+    string_ref(string_ref &&o) noexcept : _ctx(o._ctx), _s(o._s), _len(o._len) { o._s = nullptr; }
+    string_ref &operator=(string_ref &&o) noexcept {
+        if (this != &o) {
+            if (_s != nullptr)
+                JS_FreeCString(_ctx, _s);
+            _ctx = o._ctx;
+            _s = o._s;
+            _len = o._len;
+            o._s = nullptr;
+        }
+        return *this;
+    }
+    JNJS_IMPL_NON_COPYABLE(string_ref)
+
+    /**
+     * @brief Get the string contents.
+     * @return View of the string, valid for the lifetime of this string_ref.
+     */
+    [[nodiscard]] std::string_view view() const { return {c_str(), _len}; }
+    /**
+     * @brief Get the string contents as a null terminated string.
+     * @return The string, valid for the lifetime of this string_ref.
+     */
+    [[nodiscard]] const char *c_str() const { return _s != nullptr ? _s : ""; }
+    [[nodiscard]] size_t size() const { return _len; }
+    [[nodiscard]] bool empty() const { return _len == 0; }
+    /**
+     * @brief Check if the string holds converted contents.
+     * @return False if default constructed, or if converting the value threw.
+     */
+    [[nodiscard]] bool valid() const { return _s != nullptr; }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator std::string_view() const { return view(); }
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator const char *() const { return c_str(); }
+
+  private:
+    /**
+     * @internal
+     * @brief Take ownership of a string returned by JS_ToCStringLen.
+     */
+    string_ref(JSContext *ctx, const char *s, size_t len) : _ctx(ctx), _s(s), _len(len) {}
+
+    JSContext *_ctx = nullptr;
+    const char *_s = nullptr;
+    size_t _len = 0;
+    friend detail::value_helpers<string_ref>;
+};
+
+/**
+ * @note Converting a value that can not be turned into a string (e.g. a symbol) yields an empty string and leaves the
+ * exception pending.
+ */
+template <> struct detail::value_helpers<string_ref> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static string_ref as(JSContext *c, JSValue v) {
+        size_t len = 0;
+        const char *s = JS_ToCStringLen(c, &len, v);
+        return {c, s, s != nullptr ? len : 0};
+    }
+    static JSValue from(JSContext *c, const string_ref &v) { return JS_NewStringLen(c, v.c_str(), v.size()); }
+};
+
+/**
+ * @note There is no `as`, since the view would outlive the string it points into, convert to string_ref instead.
+ */
+template <> struct detail::value_helpers<std::string_view> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static JSValue from(JSContext *c, const std::string_view &v) { return JS_NewStringLen(c, v.data(), v.size()); }
+};
+
+/**
+ * @note There is no `as`, since the pointer would outlive the string it points to, convert to string_ref instead.
+ */
+template <> struct detail::value_helpers<const char *> {
+    static bool is(JSContext *, JSValue v) { return JS_IsString(v); }
+    static bool is_convertible(JSContext *, JSValue v) { return !JS_IsSymbol(v); }
+    static JSValue from(JSContext *c, const char *v) { return JS_NewString(c, v); }
+};
+
+} // namespace jnjs
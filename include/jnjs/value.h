@@ -4,8 +4,18 @@
  * @brief Wrapper classes for JavaScript values.
  */
 
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 #include <quickjs.h>
 
+#include "error.h"
+#include "prop_key.h"
+#include "serialized.h"
+#include "string_ref.h"
+
 #include "detail/value_helpers.h"
 
 namespace jnjs {
@@ -22,6 +32,7 @@ class value {
     // Release the value
     ~value() noexcept {
         if (_ctx != nullptr) {
+            detail::check_unborrowed(_ctx, this);
             JS_FreeValue(_ctx, _v);
         }
     }
@@ -33,6 +44,7 @@ class value {
     // Move the value, transferring ownership
     value &operator=(const value &o) noexcept {
         if (this != &o) {
+            detail::check_unborrowed(_ctx, this);
             if (o._ctx != nullptr) {
                 _v = JS_DupValue(o._ctx, o._v);
                 _ctx = o._ctx;
@@ -46,6 +58,8 @@ class value {
     // Create a copy of the value
     value &operator=(value &&o) noexcept {
         if (this != &o) {
+            detail::check_unborrowed(_ctx, this);
+            detail::check_unborrowed(o._ctx, &o);
             _v = o._v;
             _ctx = o._ctx;
             o._v = JS_UNDEFINED;
@@ -93,6 +107,68 @@ class value {
         return value(r, _ctx);
     }
 
+    /**
+     * @brief Get a property of the value by a cached key.
+     * @param key Key of the property to access.
+     * @return The value of the property, or undefined if the property does not exist.
+     */
+    value operator[](const prop_key &key) const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return value(JS_GetProperty(_ctx, _v, key.atom(_ctx)), _ctx);
+    }
+
+    /**
+     * @brief Get several properties at once.
+     * @tparam Keys Types of the keys, all prop_key.
+     * @param keys Keys of the properties to access.
+     * @return The values of the properties, in the order of `keys`.
+     */
+    template <typename... Keys> std::array<value, sizeof...(Keys)> get_many(const Keys &...keys) const {
+        static_assert((std::is_same_v<Keys, prop_key> && ...), "get_many takes prop_keys");
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return {};
+        }
+        return {value(JS_GetProperty(_ctx, _v, keys.atom(_ctx)), _ctx)...};
+    }
+
+    /**
+     * @brief Set a property of the value.
+     * @tparam T Type of the new property value.
+     * @param key Key of the property to set.
+     * @param v New value of the property.
+     * @return If the property was set, false if the value is not an object or the setter threw, in which case the
+     * exception is discarded.
+     */
+    template <typename T> bool set(const prop_key &key, const T &v) const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return false;
+        }
+        const auto r = JS_SetProperty(_ctx, _v, key.atom(_ctx), detail::value_helpers<T>::from(_ctx, v));
+        if (HEDLEY_UNLIKELY(r < 0)) {
+            // the failure is reported as false, don't leave the exception for the next operation to pick up
+            JS_FreeValue(_ctx, JS_GetException(_ctx));
+        }
+        return r > 0;
+    }
+
+    /**
+     * @brief Check if the value has a property, including inherited ones.
+     * @param key Key of the property.
+     * @return If the property exists.
+     */
+    [[nodiscard]] bool has(const prop_key &key) const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return false;
+        }
+        const auto r = JS_HasProperty(_ctx, _v, key.atom(_ctx));
+        if (HEDLEY_UNLIKELY(r < 0)) {
+            JS_FreeValue(_ctx, JS_GetException(_ctx));
+        }
+        return r > 0;
+    }
+
     /**
      * @brief Strictly compare this value to another value.
      * @tparam T Type to compare to
@@ -135,6 +211,75 @@ class value {
      */
     template <typename T> T as() const { return detail::value_helpers<T>::as(_ctx, _v); }
 
+    /**
+     * @brief Serialize the value as JSON, like `JSON.stringify`, handing the text to a sink.
+     *
+     * The sink receives the text directly from the string QuickJS produced, without an intermediate std::string. It
+     * can be a callable taking a `std::string_view`, a container such as `std::string` or `std::vector<char>` to
+     * append to, or a stream with `write(const char *, size)`.
+     *
+     * @tparam Sink Type of the sink.
+     * @param sink Where to write the text.
+     * @param indent Number of spaces to indent nested levels with, 0 for compact output.
+     * @return If text was written, false if the value has no JSON representation (e.g. undefined or a function).
+     * @throws js_error if serialization throws, e.g. on cyclic structures or BigInts.
+     */
+    template <typename Sink>
+        requires(!std::is_arithmetic_v<std::remove_cvref_t<Sink>>)
+    bool to_json(Sink &&sink, int indent = 0) const {
+        if (HEDLEY_UNLIKELY(_ctx == nullptr)) {
+            return false;
+        }
+        const auto str = _stringify(indent);
+        if (!str.valid()) {
+            return false;
+        }
+        const auto text = str.view();
+        if constexpr (std::is_invocable_v<Sink &, std::string_view>) {
+            sink(text);
+        } else if constexpr (requires { sink.write(text.data(), text.size()); }) {
+            sink.write(text.data(), text.size());
+        } else {
+            sink.insert(sink.end(), text.begin(), text.end());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Serialize the value as JSON, like `JSON.stringify`.
+     * @param indent Number of spaces to indent nested levels with, 0 for compact output.
+     * @return The JSON text, empty if the value has no JSON representation (e.g. undefined or a function).
+     * @throws js_error if serialization throws, e.g. on cyclic structures or BigInts.
+     */
+    [[nodiscard]] std::string to_json(int indent = 0) const {
+        std::string ret;
+        to_json(ret, indent);
+        return ret;
+    }
+
+    /**
+     * @brief Serialize the value to move it to another context, runtime or thread.
+     *
+     * Reuses the buffer already held by `out`, so sending many messages through one serialized does not allocate once
+     * it has grown large enough. A default constructed value serializes to an empty message.
+     *
+     * @param out Message to overwrite.
+     * @param share_buffers Pass SharedArrayBuffers through by reference, serializing them throws if false.
+     * @throws js_error if the value can not be serialized, e.g. because it holds a function.
+     */
+    void serialize(serialized &out, bool share_buffers = true) const;
+    /**
+     * @brief Serialize the value to move it to another context, runtime or thread.
+     * @param share_buffers Pass SharedArrayBuffers through by reference, serializing them throws if false.
+     * @return The message, read it with context::deserialize.
+     * @throws js_error if the value can not be serialized, e.g. because it holds a function.
+     */
+    [[nodiscard]] serialized serialize(bool share_buffers = true) const {
+        serialized ret;
+        serialize(ret, share_buffers);
+        return ret;
+    }
+
   private:
     /**
      * @internal Create a value from a JSValue and a JSContext.
@@ -143,10 +288,37 @@ class value {
      */
     explicit value(JSValue v, JSContext *ctx) : _v(v), _ctx(ctx) {}
 
+    /**
+     * @internal
+     * @brief Run JSON.stringify on the value.
+     * @return The JSON text, invalid if the value has no JSON representation.
+     */
+    string_ref _stringify(int indent) const {
+        const auto space = indent > 0 ? JS_NewInt32(_ctx, indent) : JS_UNDEFINED;
+        const auto s = JS_JSONStringify(_ctx, _v, JS_UNDEFINED, space);
+        if (HEDLEY_UNLIKELY(JS_IsException(s))) {
+            throw detail::value_helpers<js_error>::as(_ctx, s);
+        }
+        if (!JS_IsString(s)) {
+            JS_FreeValue(_ctx, s);
+            return {};
+        }
+        auto ret = detail::value_helpers<string_ref>::as(_ctx, s);
+        JS_FreeValue(_ctx, s);
+        if (HEDLEY_UNLIKELY(!ret.valid())) {
+            throw detail::value_helpers<js_error>::as(_ctx, JS_EXCEPTION);
+        }
+        return ret;
+    }
+
     JSValue _v = JS_UNDEFINED; /**< @internal The underlying JSValue. */
     JSContext *_ctx = nullptr; /**< @internal The JavaScript context in which the value exists. */
+    friend borrowed_value;
+    friend bundle;
     friend context;
     friend function;
+    friend script;
+    friend value_scope;
     friend detail::value_helpers<value>;
     friend detail::value_helpers<function>;
 };
@@ -0,0 +1,133 @@
+#pragma once
+/**
+ * @file value_scope.h
+ * @brief Scope releasing temporary values in one pass.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <quickjs.h>
+
+#include "borrowed_value.h"
+#include "context.h"
+#include "prop_key.h"
+#include "value.h"
+
+#include "detail/hedley.h"
+#include "detail/runtime_data.h"
+#include "detail/util.h"
+#include "detail/value_helpers.h"
+
+namespace jnjs {
+
+/**
+ * @brief Owns the temporary values created while walking JS data, and releases them all when it goes out of scope.
+ *
+ * Every value read through a scope is appended to one buffer and handed out as a borrowed_value, so nothing is
+ * released until the scope ends, which then frees the whole buffer in a single loop. Borrows must not outlive the
+ * scope, use borrowed_value::to_value() to keep a value beyond it.
+ *
+ * @code
+ * jnjs::value_scope scope(ctx);
+ * auto items = scope.get(root, jnjs::key<"items">);
+ * for (int i = 0; i < len; ++i) total += scope.get(scope.get(items, i), jnjs::key<"price">).as<int>();
+ * @endcode
+ *
+ * @note A scope keeps everything alive until it ends, so give each iteration of a long loop its own scope, or call
+ * clear().
+ */
+class value_scope {
+  public:
+    /**
+     * @brief Open a scope.
+     * @param ctx Context the values belong to, must outlive the scope.
+     * @param capacity Number of values to reserve space for up front.
+     */
+    explicit value_scope(context &ctx, size_t capacity = 32) : _ctx(ctx.get()) { _vals.reserve(capacity); }
+    ~value_scope() { clear(); }
+
+    JNJS_IMPL_NON_COPYABLE_MOVABLE(value_scope)
+
+    /**
+     * @brief Get a property of a value by a cached key.
+     * @param obj Value to read from.
+     * @param key Key of the property.
+     * @return The property value, owned by the scope.
+     */
+    borrowed_value get(const borrowed_value &obj, const prop_key &key) {
+        return _push(JS_GetProperty(_ctx, obj._v, key.atom(_ctx)));
+    }
+    /**
+     * @brief Get a property of a value by name.
+     * @param obj Value to read from.
+     * @param name Name of the property.
+     * @return The property value, owned by the scope.
+     */
+    borrowed_value get(const borrowed_value &obj, const char *name) {
+        return _push(JS_GetPropertyStr(_ctx, obj._v, name));
+    }
+    /**
+     * @brief Get a property of a value by index.
+     * @param obj Value to read from.
+     * @param idx Index of the property.
+     * @return The property value, owned by the scope.
+     */
+    borrowed_value get(const borrowed_value &obj, int idx) {
+        return _push(idx >= 0 ? JS_GetPropertyUint32(_ctx, obj._v, static_cast<uint32_t>(idx))
+                              : JS_GetPropertyInt64(_ctx, obj._v, idx));
+    }
+
+    /**
+     * @brief Convert a C++ value, owned by the scope.
+     * @tparam T Type of the value.
+     * @param v Value to convert.
+     * @return The new JS value.
+     */
+    template <typename T> borrowed_value make(const T &v) { return _push(detail::value_helpers<T>::from(_ctx, v)); }
+
+    /**
+     * @brief Move a value into the scope.
+     * @param v Value to take over, left undefined.
+     * @return The value, owned by the scope.
+     */
+    borrowed_value adopt(value &&v) {
+        if (HEDLEY_UNLIKELY(v._ctx == nullptr)) {
+            return {};
+        }
+        detail::check_unborrowed(v._ctx, &v);
+        auto r = _push(v._v);
+        v._v = JS_UNDEFINED;
+        v._ctx = nullptr;
+        return r;
+    }
+
+    /**
+     * @brief Get the number of values owned by the scope.
+     * @return Number of values that will be released.
+     */
+    [[nodiscard]] size_t size() const { return _vals.size(); }
+
+    /**
+     * @brief Release every value owned so far, keeping the buffer for reuse.
+     * @warning Every borrow handed out by the scope is invalidated.
+     */
+    void clear() noexcept {
+        detail::check_unborrowed(_ctx, this);
+        for (auto v : _vals) {
+            JS_FreeValue(_ctx, v);
+        }
+        _vals.clear();
+    }
+
+  private:
+    borrowed_value _push(JSValue v) {
+        _vals.push_back(v);
+        return detail::value_helpers<borrowed_value>::borrow(_ctx, v, this);
+    }
+
+    JSContext *_ctx;
+    std::vector<JSValue> _vals;
+};
+
+} // namespace jnjs
@@ -0,0 +1,372 @@
+#pragma once
+/**
+ * @file views.h
+ * @brief Lazily converted views of JavaScript arrays and objects.
+ */
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <quickjs.h>
+
+#include "error.h"
+#include "prop_key.h"
+#include "value.h"
+
+#include "detail/fwd.h"
+#include "detail/hedley.h"
+#include "detail/value_ext/map.h"
+#include "detail/value_helpers.h"
+
+namespace jnjs {
+
+namespace detail {
+/**
+ * @internal
+ * @brief A reference to a JSValue, released on destruction.
+ */
+class view_ref {
+  public:
+    view_ref() = default;
+    view_ref(JSContext *c, JSValue v) : _ctx(c), _v(v) {}
+    ~view_ref() {
+        if (_ctx != nullptr)
+            JS_FreeValue(_ctx, _v);
+    }
+    view_ref(const view_ref &o) : _ctx(o._ctx), _v(o._ctx != nullptr ? JS_DupValue(o._ctx, o._v) : o._v) {}
+    view_ref(view_ref &&o) noexcept : _ctx(o._ctx), _v(o._v) { o._ctx = nullptr; }
+    view_ref &operator=(view_ref o) noexcept {
+        std::swap(_ctx, o._ctx);
+        std::swap(_v, o._v);
+        return *this;
+    }
+
+    [[nodiscard]] JSContext *ctx() const { return _ctx; }
+    [[nodiscard]] JSValue get() const { return _v; }
+
+  private:
+    JSContext *_ctx = nullptr;
+    JSValue _v = JS_UNDEFINED;
+};
+} // namespace detail
+
+/**
+ * @brief A JS array (or TypedArray) whose elements are converted one at a time, when they are read.
+ *
+ * Taking an array_view instead of a `std::vector` lets a bound function look at a few elements of a large array
+ * without converting all of them first. The length is read once, when the view is created.
+ * @tparam T Element type.
+ *
+ * @code
+ * int first_or(jnjs::array_view<int> a, int def) { return a.empty() ? def : a[0]; }
+ * @endcode
+ */
+template <typename T> class array_view {
+  public:
+    /**
+     * @brief Random access iterator converting the element it points to on every dereference.
+     */
+    class iterator {
+      public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = T;
+
+        iterator() = default;
+
+        T operator*() const { return (*_view)[_i]; }
+        T operator[](difference_type n) const { return (*_view)[_i + n]; }
+        iterator &operator++() {
+            ++_i;
+            return *this;
+        }
+        iterator operator++(int) { return {_view, _i++}; }
+        iterator &operator--() {
+            --_i;
+            return *this;
+        }
+        iterator operator--(int) { return {_view, _i--}; }
+        iterator &operator+=(difference_type n) {
+            _i += n;
+            return *this;
+        }
+        iterator &operator-=(difference_type n) {
+            _i -= n;
+            return *this;
+        }
+        friend iterator operator+(iterator it, difference_type n) { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iterator &a, const iterator &b) {
+            return static_cast<difference_type>(a._i) - static_cast<difference_type>(b._i);
+        }
+        friend bool operator==(const iterator &a, const iterator &b) { return a._i == b._i; }
+        friend auto operator<=>(const iterator &a, const iterator &b) { return a._i <=> b._i; }
+
+      private:
+        iterator(const array_view *v, size_t i) : _view(v), _i(i) {}
+
+        const array_view *_view = nullptr;
+        size_t _i = 0;
+        friend array_view;
+    };
+
+    // Create an empty view.
+    array_view() = default;
+
+    /**
+     * @brief Convert an element.
+     * @param i Index of the element, must be below size().
+     * @return The converted element.
+     * @throws js_error if the element getter throws.
+     */
+    T operator[](size_t i) const {
+        auto c = _ref.ctx();
+        const detail::view_ref v(c, i <= UINT32_MAX ? JS_GetPropertyUint32(c, _ref.get(), static_cast<uint32_t>(i))
+                                                    : JS_GetPropertyInt64(c, _ref.get(), static_cast<int64_t>(i)));
+        if (HEDLEY_UNLIKELY(JS_IsException(v.get())))
+            throw detail::value_helpers<js_error>::as(c, JS_EXCEPTION);
+        return detail::value_helpers<T>::as(c, v.get());
+    }
+    /**
+     * @brief Convert an element, checking the index.
+     * @param i Index of the element.
+     * @return The converted element.
+     * @throws std::out_of_range if `i` is not below size().
+     */
+    T at(size_t i) const {
+        if (HEDLEY_UNLIKELY(i >= _size))
+            throw std::out_of_range("array_view::at");
+        return (*this)[i];
+    }
+
+    [[nodiscard]] size_t size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+    [[nodiscard]] iterator begin() const { return {this, 0}; }
+    [[nodiscard]] iterator end() const { return {this, _size}; }
+
+    /**
+     * @brief Get the viewed array.
+     * @return A new reference to the array.
+     */
+    [[nodiscard]] value to_value() const {
+        return _ref.ctx() != nullptr ? detail::value_helpers<value>::as(_ref.ctx(), _ref.get()) : value();
+    }
+
+  private:
+    array_view(JSContext *c, JSValue v) : _ref(c, JS_DupValue(c, v)) {
+        int64_t len = 0;
+        if (JS_GetLength(c, v, &len) < 0 || len < 0)
+            len = 0;
+        _size = static_cast<size_t>(len);
+    }
+
+    detail::view_ref _ref;
+    size_t _size = 0;
+    friend detail::value_helpers<array_view>;
+};
+
+/**
+ * @brief A JS object whose properties are converted one at a time, when they are read.
+ *
+ * Lookups go straight to the object. Iterating enumerates the own enumerable string keys once, like Object.keys, and
+ * converts each value as it is reached.
+ * @tparam V Property value type.
+ *
+ * @code
+ * bool is_admin(jnjs::object_view<bool> flags) { return flags.find("admin").value_or(false); }
+ * @endcode
+ */
+template <typename V> class object_view {
+    struct key_table {
+        JSContext *ctx = nullptr;
+        JSPropertyEnum *tab = nullptr;
+        uint32_t len = 0;
+        ~key_table() {
+            if (tab != nullptr)
+                JS_FreePropertyEnum(ctx, tab, len);
+        }
+    };
+
+  public:
+    /**
+     * @brief Forward iterator over key and converted value pairs.
+     */
+    class iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::pair<std::string, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        iterator() = default;
+
+        value_type operator*() const {
+            const auto atom = _keys->tab[_i].atom;
+            return {detail::atom_to_key<std::string>(_view->_ref.ctx(), atom), _view->_get(atom)};
+        }
+        iterator &operator++() {
+            ++_i;
+            return *this;
+        }
+        iterator operator++(int) {
+            auto r = *this;
+            ++_i;
+            return r;
+        }
+        friend bool operator==(const iterator &a, const iterator &b) { return a._i == b._i; }
+
+      private:
+        iterator(const object_view *v, const key_table *k, uint32_t i) : _view(v), _keys(k), _i(i) {}
+
+        const object_view *_view = nullptr;
+        const key_table *_keys = nullptr;
+        uint32_t _i = 0;
+        friend object_view;
+    };
+
+    // Create an empty view.
+    object_view() = default;
+
+    /**
+     * @brief Convert a property if it exists.
+     * @param key Cached key of the property.
+     * @return The converted value, or nullopt if the object has no such property.
+     * @throws js_error if the property getter throws.
+     */
+    std::optional<V> find(const prop_key &key) const { return _find(key.atom(_ref.ctx())); }
+    /**
+     * @brief Convert a property if it exists.
+     * @param name Name of the property.
+     * @return The converted value, or nullopt if the object has no such property.
+     * @throws js_error if the property getter throws.
+     */
+    std::optional<V> find(std::string_view name) const {
+        if (HEDLEY_UNLIKELY(_ref.ctx() == nullptr))
+            return std::nullopt;
+        const auto atom = JS_NewAtomLen(_ref.ctx(), name.data(), name.size());
+        auto ret = _find(atom);
+        JS_FreeAtom(_ref.ctx(), atom);
+        return ret;
+    }
+    /**
+     * @brief Convert a property.
+     * @param name Name of the property.
+     * @return The converted value.
+     * @throws std::out_of_range if the object has no such property.
+     * @throws js_error if the property getter throws.
+     */
+    template <typename K> V at(const K &name) const {
+        auto ret = find(name);
+        if (HEDLEY_UNLIKELY(!ret))
+            throw std::out_of_range("object_view::at");
+        return std::move(*ret);
+    }
+    /**
+     * @brief Check if the object has a property, including inherited ones.
+     * @param key Cached key of the property.
+     * @return If the property exists.
+     */
+    [[nodiscard]] bool contains(const prop_key &key) const {
+        return _ref.ctx() != nullptr && JS_HasProperty(_ref.ctx(), _ref.get(), key.atom(_ref.ctx())) > 0;
+    }
+
+    /**
+     * @brief Get the number of own enumerable string keyed properties.
+     * @note Enumerates the keys on first use.
+     */
+    [[nodiscard]] size_t size() const { return _table()->len; }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] iterator begin() const { return {this, _table(), 0}; }
+    [[nodiscard]] iterator end() const {
+        const auto *t = _table();
+        return {this, t, t->len};
+    }
+
+    /**
+     * @brief Get the viewed object.
+     * @return A new reference to the object.
+     */
+    [[nodiscard]] value to_value() const {
+        return _ref.ctx() != nullptr ? detail::value_helpers<value>::as(_ref.ctx(), _ref.get()) : value();
+    }
+
+  private:
+    object_view(JSContext *c, JSValue v) : _ref(c, JS_DupValue(c, v)) {}
+
+    V _get(JSAtom atom) const {
+        const detail::view_ref v(_ref.ctx(), JS_GetProperty(_ref.ctx(), _ref.get(), atom));
+        if (HEDLEY_UNLIKELY(JS_IsException(v.get())))
+            throw detail::value_helpers<js_error>::as(_ref.ctx(), JS_EXCEPTION);
+        return detail::value_helpers<V>::as(_ref.ctx(), v.get());
+    }
+    std::optional<V> _find(JSAtom atom) const {
+        if (HEDLEY_UNLIKELY(_ref.ctx() == nullptr))
+            return std::nullopt;
+        const detail::view_ref v(_ref.ctx(), JS_GetProperty(_ref.ctx(), _ref.get(), atom));
+        if (HEDLEY_UNLIKELY(JS_IsException(v.get())))
+            throw detail::value_helpers<js_error>::as(_ref.ctx(), JS_EXCEPTION);
+        // a property explicitly set to undefined is treated as missing, which spares a JS_HasProperty
+        if (JS_IsUndefined(v.get()))
+            return std::nullopt;
+        return detail::value_helpers<V>::as(_ref.ctx(), v.get());
+    }
+    const key_table *_table() const {
+        if (!_keys) {
+            _keys = std::make_shared<key_table>();
+            _keys->ctx = _ref.ctx();
+            if (_ref.ctx() != nullptr && JS_GetOwnPropertyNames(_ref.ctx(), &_keys->tab, &_keys->len, _ref.get(),
+                                                                JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+                _keys->tab = nullptr;
+                _keys->len = 0;
+            }
+        }
+        return _keys.get();
+    }
+
+    detail::view_ref _ref;
+    mutable std::shared_ptr<key_table> _keys; /**< Enumerated keys, shared between copies. */
+    friend detail::value_helpers<object_view>;
+};
+
+/**
+ * @note Accepts arrays and TypedArrays.
+ */
+template <typename T> struct detail::value_helpers<array_view<T>> {
+    static bool is(JSContext *, JSValue v) { return JS_IsArray(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v) || JS_GetTypedArrayType(v) >= 0; }
+    static array_view<T> as(JSContext *c, JSValue v) {
+        if (!is_convertible(c, v))
+            return {};
+        return {c, v};
+    }
+    static JSValue from(JSContext *c, const array_view<T> &v) {
+        return v._ref.ctx() != nullptr ? JS_DupValue(c, v._ref.get()) : JS_NewArray(c);
+    }
+};
+
+template <typename V> struct detail::value_helpers<object_view<V>> {
+    static bool is(JSContext *, JSValue v) { return JS_IsObject(v); }
+    static bool is_convertible(JSContext *c, JSValue v) { return is(c, v); }
+    static object_view<V> as(JSContext *c, JSValue v) {
+        if (!is(c, v))
+            return {};
+        return {c, v};
+    }
+    static JSValue from(JSContext *c, const object_view<V> &v) {
+        return v._ref.ctx() != nullptr ? JS_DupValue(c, v._ref.get()) : JS_NewObject(c);
+    }
+};
+
+} // namespace jnjs
@@ -1,5 +1,8 @@
 #include <cassert>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string_view>
 
 #include <jnjs/jnjs.h>
 
@@ -53,9 +56,46 @@ jnjs::value eval_log(jnjs::context &ctx, const char *code) {
     }
     return r;
 }
+
+// jnjs_cli bundle <output> <files...>, files ending in .mjs are compiled as modules
+int make_bundle(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " bundle <output> <files...>" << std::endl;
+        return 1;
+    }
+    auto ctx = jnjs::runtime::new_context();
+    jnjs::bundle_writer writer(ctx);
+    for (int i = 3; i < argc; ++i) {
+        const std::string name = argv[i];
+        std::ifstream f(name, std::ios::binary);
+        if (!f) {
+            std::cerr << "could not read " << name << std::endl;
+            return 1;
+        }
+        std::stringstream source;
+        source << f.rdbuf();
+        try {
+            if (name.ends_with(".mjs"))
+                writer.add_module(name, source.str());
+            else
+                writer.add_script(name, source.str());
+        } catch (const jnjs::js_error &e) {
+            std::cerr << name << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (!writer.write(argv[2])) {
+        std::cerr << "could not write " << argv[2] << std::endl;
+        return 1;
+    }
+    return 0;
+}
 } // namespace
 
-int main() {
+int main(int argc, char **argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "bundle")
+        return make_bundle(argc, argv);
+
     auto ctx = jnjs::runtime::new_context();
     ctx.install_class<test_class>();
     ctx.install_class<class_2>();
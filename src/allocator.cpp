@@ -0,0 +1,202 @@
+#include <jnjs/allocator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace jnjs {
+
+void *allocator::reallocate(void *p, size_t old_size, size_t new_size) {
+    auto *r = allocate(new_size);
+    if (r == nullptr)
+        return nullptr;
+    std::memcpy(r, p, std::min(old_size, new_size));
+    deallocate(p, old_size);
+    return r;
+}
+
+pool_allocator::pool_allocator(size_t chunk_size) : _chunk_size(std::max(chunk_size, max_pooled_size)) {}
+
+pool_allocator::~pool_allocator() {
+    for (auto *c : _chunks) {
+        std::free(c);
+    }
+}
+
+void *pool_allocator::allocate(size_t size) {
+    if (size > max_pooled_size)
+        return std::malloc(size);
+
+    const auto cls = class_of(size);
+    if (auto *b = _free[cls]) {
+        _free[cls] = b->next;
+        return b;
+    }
+
+    const auto block = (cls + 1) * granularity;
+    if (static_cast<size_t>(_end - _cur) < block) {
+        auto *c = static_cast<char *>(std::malloc(_chunk_size));
+        if (c == nullptr)
+            return nullptr;
+        _chunks.push_back(c);
+        _cur = c;
+        _end = c + _chunk_size;
+    }
+    auto *r = _cur;
+    _cur += block;
+    return r;
+}
+
+void pool_allocator::deallocate(void *p, size_t size) noexcept {
+    if (size > max_pooled_size) {
+        std::free(p);
+        return;
+    }
+    const auto cls = class_of(size);
+    auto *b = static_cast<free_block *>(p);
+    b->next = _free[cls];
+    _free[cls] = b;
+}
+
+void *pool_allocator::reallocate(void *p, size_t old_size, size_t new_size) {
+    if (old_size > max_pooled_size && new_size > max_pooled_size)
+        return std::realloc(p, new_size);
+    if (old_size <= max_pooled_size && new_size <= max_pooled_size && class_of(old_size) == class_of(new_size))
+        return p;
+    return allocator::reallocate(p, old_size, new_size);
+}
+
+arena_allocator::arena_allocator(size_t block_size) : _block_size(round(block_size)) {}
+
+arena_allocator::~arena_allocator() {
+    for (auto *b : _blocks) {
+        std::free(b);
+    }
+    for (auto *b : _large) {
+        std::free(b);
+    }
+}
+
+void *arena_allocator::allocate(size_t size) {
+    size = round(size);
+    if (size > _block_size / 4) {
+        auto *r = std::malloc(size);
+        if (r == nullptr)
+            return nullptr;
+        _large.insert(r);
+        _reserved += size;
+        return r;
+    }
+    if (static_cast<size_t>(_end - _cur) < size) {
+        auto *b = static_cast<char *>(std::malloc(_block_size));
+        if (b == nullptr)
+            return nullptr;
+        _blocks.push_back(b);
+        _reserved += _block_size;
+        _cur = b;
+        _end = b + _block_size;
+    }
+    auto *r = _cur;
+    _cur += size;
+    return r;
+}
+
+void arena_allocator::deallocate(void *p, size_t size) noexcept {
+    size = round(size);
+    if (size > _block_size / 4) {
+        _large.erase(p);
+        _reserved -= size;
+        std::free(p);
+        return;
+    }
+    // only the most recent allocation can be given back
+    if (static_cast<char *>(p) + size == _cur) {
+        _cur = static_cast<char *>(p);
+    }
+}
+
+void *arena_allocator::reallocate(void *p, size_t old_size, size_t new_size) {
+    const auto old_r = round(old_size);
+    const auto new_r = round(new_size);
+    if (old_r <= _block_size / 4 && new_r <= _block_size / 4) {
+        if (new_r <= old_r)
+            return p;
+        // grow in place when this is the most recent allocation
+        if (static_cast<char *>(p) + old_r == _cur && static_cast<size_t>(_end - static_cast<char *>(p)) >= new_r) {
+            _cur = static_cast<char *>(p) + new_r;
+            return p;
+        }
+    }
+    return allocator::reallocate(p, old_size, new_size);
+}
+
+namespace detail {
+namespace {
+// every block carries its size in front of it, since js_malloc_usable_size is not given the opaque
+constexpr size_t header_size = 16;
+
+void *shim_malloc(void *opaque, size_t size) {
+    auto *a = static_cast<allocator *>(opaque);
+    auto *p = static_cast<char *>(a->allocate(size + header_size));
+    if (p == nullptr)
+        return nullptr;
+    *reinterpret_cast<size_t *>(p) = size;
+    return p + header_size;
+}
+
+void *shim_calloc(void *opaque, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size)
+        return nullptr;
+    auto *p = shim_malloc(opaque, count * size);
+    if (p != nullptr)
+        std::memset(p, 0, count * size);
+    return p;
+}
+
+void shim_free(void *opaque, void *ptr) {
+    if (ptr == nullptr)
+        return;
+    auto *p = static_cast<char *>(ptr) - header_size;
+    static_cast<allocator *>(opaque)->deallocate(p, *reinterpret_cast<size_t *>(p) + header_size);
+}
+
+void *shim_realloc(void *opaque, void *ptr, size_t size) {
+    if (ptr == nullptr)
+        return size == 0 ? nullptr : shim_malloc(opaque, size);
+    if (size == 0) {
+        shim_free(opaque, ptr);
+        return nullptr;
+    }
+    auto *p = static_cast<char *>(ptr) - header_size;
+    const auto old_size = *reinterpret_cast<size_t *>(p);
+    auto *r = static_cast<char *>(
+        static_cast<allocator *>(opaque)->reallocate(p, old_size + header_size, size + header_size));
+    if (r == nullptr)
+        return nullptr;
+    *reinterpret_cast<size_t *>(r) = size;
+    return r + header_size;
+}
+
+size_t shim_usable_size(const void *ptr) {
+    if (ptr == nullptr)
+        return 0;
+    return *reinterpret_cast<const size_t *>(static_cast<const char *>(ptr) - header_size);
+}
+} // namespace
+
+const JSMallocFunctions &allocator_malloc_functions() {
+    static const JSMallocFunctions fns = [] {
+        JSMallocFunctions f = {};
+        f.js_calloc = shim_calloc;
+        f.js_malloc = shim_malloc;
+        f.js_free = shim_free;
+        f.js_realloc = shim_realloc;
+        f.js_malloc_usable_size = shim_usable_size;
+        return f;
+    }();
+    return fns;
+}
+} // namespace detail
+
+} // namespace jnjs
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace jnjs::detail {
+
+/**
+ * @internal
+ * @brief Write a file through a temporary file renamed into place, so readers never see it half written.
+ * @param dest Path of the file.
+ * @param data Contents to write.
+ * @param size Size of `data` in bytes.
+ * @return If the file was written.
+ */
+inline bool write_file_atomic(const std::filesystem::path &dest, const uint8_t *data, size_t size) {
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(rng()));
+    auto tmp = dest;
+    tmp += suffix;
+    std::error_code ec;
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f)
+            return false;
+        f.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+        if (!f.flush()) {
+            f.close();
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, dest, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace jnjs::detail
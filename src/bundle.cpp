@@ -0,0 +1,232 @@
+#include <jnjs/bundle.h>
+#include <jnjs/error.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "atomic_file.h"
+
+namespace jnjs {
+
+namespace {
+constexpr char magic[8] = {'j', 'n', 'j', 's', 'b', 'n', 'd', '\0'};
+constexpr uint32_t format_version = 1;
+
+// all offsets are from the start of the file, integers are in native byte order
+struct header {
+    char magic[8];
+    uint32_t format;
+    uint32_t count;
+    uint64_t index_offset;
+    char version[32]; /**< JS_GetVersion() of the writer, null padded. */
+};
+
+void version_field(char (&out)[32]) {
+    std::memset(out, 0, sizeof(out));
+    std::strncpy(out, JS_GetVersion(), sizeof(out) - 1);
+}
+} // namespace
+
+struct bundle::index_entry {
+    uint64_t name_offset;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint32_t name_size;
+    kind type;
+};
+
+struct bundle::mapping {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::vector<uint8_t> buf;
+#else
+    ~mapping() {
+        if (data != nullptr)
+            munmap(const_cast<uint8_t *>(data), size);
+    }
+#endif
+};
+
+bundle::bundle(const std::filesystem::path &path) : _map(std::make_unique<mapping>()) {
+#ifdef _WIN32
+    // no mmap, read the whole file instead
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f)
+        throw std::runtime_error("could not open bundle " + path.string());
+    _map->buf.resize(static_cast<size_t>(f.tellg()));
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char *>(_map->buf.data()), static_cast<std::streamsize>(_map->buf.size())))
+        throw std::runtime_error("could not read bundle " + path.string());
+    _map->data = _map->buf.data();
+    _map->size = _map->buf.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("could not open bundle " + path.string());
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("could not read bundle " + path.string());
+    }
+    void *p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        throw std::runtime_error("could not map bundle " + path.string());
+    _map->data = static_cast<const uint8_t *>(p);
+    _map->size = static_cast<size_t>(st.st_size);
+#endif
+
+    const auto *data = _map->data;
+    const auto size = _map->size;
+    header h;
+    char version[32];
+    version_field(version);
+    if (size < sizeof(h))
+        throw std::runtime_error("not a bundle: " + path.string());
+    std::memcpy(&h, data, sizeof(h));
+    if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.format != format_version)
+        throw std::runtime_error("not a bundle: " + path.string());
+    if (std::memcmp(h.version, version, sizeof(version)) != 0)
+        throw std::runtime_error("bundle was written for another QuickJS version: " + path.string());
+    if (h.index_offset % alignof(index_entry) != 0 || h.index_offset > size ||
+        (size - h.index_offset) / sizeof(index_entry) < h.count)
+        throw std::runtime_error("damaged bundle: " + path.string());
+
+    _index = reinterpret_cast<const index_entry *>(data + h.index_offset);
+    _count = h.count;
+    for (size_t i = 0; i < _count; ++i) {
+        const auto &e = _index[i];
+        if (e.name_offset > size || size - e.name_offset < e.name_size || e.data_offset > size ||
+            size - e.data_offset < e.data_size)
+            throw std::runtime_error("damaged bundle: " + path.string());
+    }
+}
+
+bundle::~bundle() = default;
+
+const bundle::index_entry *bundle::_find(std::string_view name) const {
+    const auto name_of = [this](const index_entry &e) {
+        return std::string_view(reinterpret_cast<const char *>(_map->data + e.name_offset), e.name_size);
+    };
+    const auto *end = _index + _count;
+    const auto *it =
+        std::lower_bound(_index, end, name, [&](const index_entry &e, std::string_view n) { return name_of(e) < n; });
+    return it != end && name_of(*it) == name ? it : nullptr;
+}
+
+JSValue bundle::_read(JSContext *ctx, const index_entry &e) const {
+    return JS_ReadObject(ctx, _map->data + e.data_offset, e.data_size, JS_READ_OBJ_BYTECODE);
+}
+
+value bundle::run(context &ctx, std::string_view name) const {
+    auto *c = ctx.get();
+    const auto *e = _find(name);
+    if (e == nullptr) {
+        const auto len = static_cast<int>(name.size());
+        return value(JS_ThrowReferenceError(c, "bundle has no entry '%.*s'", len, name.data()), c);
+    }
+    auto fn = _read(c, *e);
+    if (JS_IsException(fn))
+        return value(fn, c);
+    // like qjs, link a module's imports before running it
+    if (JS_VALUE_GET_TAG(fn) == JS_TAG_MODULE && JS_ResolveModule(c, fn) < 0) {
+        JS_FreeValue(c, fn);
+        return value(JS_EXCEPTION, c);
+    }
+    const detail::run_scope running(c);
+    return value(JS_EvalFunction(c, fn), c);
+}
+
+JSModuleDef *bundle::_load_module(JSContext *ctx, const char *name, void *opaque) {
+    const auto *b = static_cast<const bundle *>(opaque);
+    const auto *e = b->_find(name);
+    if (e == nullptr || e->type != kind::module) {
+        JS_ThrowReferenceError(ctx, "could not load module '%s'", name);
+        return nullptr;
+    }
+    auto m = b->_read(ctx, *e);
+    if (JS_IsException(m))
+        return nullptr;
+    // the module stays alive in the context's module list
+    auto *def = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(m));
+    JS_FreeValue(ctx, m);
+    return def;
+}
+
+void bundle_writer::_add(std::string name, std::string_view source, bundle::kind k) {
+    auto *ctx = _ctx.get();
+    const std::string code(source);
+    const int flags = k == bundle::kind::module ? JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY
+                                                : JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY;
+    auto fn = JS_Eval(ctx, code.c_str(), code.size(), name.c_str(), flags);
+    if (JS_IsException(fn))
+        throw detail::value_helpers<js_error>::as(ctx, fn);
+    size_t len;
+    auto *buf = JS_WriteObject(ctx, &len, fn, JS_WRITE_OBJ_BYTECODE);
+    JS_FreeValue(ctx, fn);
+    if (buf == nullptr)
+        throw detail::value_helpers<js_error>::as(ctx, JS_EXCEPTION);
+    entry e{std::move(name), k, std::vector<uint8_t>(buf, buf + len)};
+    js_free(ctx, buf);
+
+    auto it = std::find_if(_entries.begin(), _entries.end(), [&e](const entry &o) { return o.name == e.name; });
+    if (it != _entries.end())
+        *it = std::move(e);
+    else
+        _entries.push_back(std::move(e));
+}
+
+bool bundle_writer::write(const std::filesystem::path &path) const {
+    std::vector<const entry *> sorted;
+    sorted.reserve(_entries.size());
+    for (const auto &e : _entries) {
+        sorted.push_back(&e);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const entry *a, const entry *b) { return a->name < b->name; });
+
+    // header, names, index, then the bytecode of every entry
+    const auto align = [](size_t v) { return (v + 7) & ~size_t(7); };
+    size_t names_size = 0;
+    for (const auto *e : sorted) {
+        names_size += e->name.size();
+    }
+    const size_t index_offset = align(sizeof(header) + names_size);
+    size_t data_offset = index_offset + sorted.size() * sizeof(bundle::index_entry);
+
+    std::vector<uint8_t> out(data_offset);
+    header h = {};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.format = format_version;
+    h.count = static_cast<uint32_t>(sorted.size());
+    h.index_offset = index_offset;
+    version_field(h.version);
+    std::memcpy(out.data(), &h, sizeof(h));
+
+    size_t name_offset = sizeof(header);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const auto &e = *sorted[i];
+        std::memcpy(out.data() + name_offset, e.name.data(), e.name.size());
+        const bundle::index_entry ie = {name_offset, data_offset, e.bytecode.size(),
+                                        static_cast<uint32_t>(e.name.size()), e.kind};
+        std::memcpy(out.data() + index_offset + i * sizeof(ie), &ie, sizeof(ie));
+        name_offset += e.name.size();
+        data_offset += e.bytecode.size();
+    }
+    for (const auto *e : sorted) {
+        out.insert(out.end(), e->bytecode.begin(), e->bytecode.end());
+    }
+    return detail::write_file_atomic(path, out.data(), out.size());
+}
+
+} // namespace jnjs
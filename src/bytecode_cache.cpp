@@ -0,0 +1,135 @@
+#include <jnjs/bytecode_cache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "atomic_file.h"
+
+namespace jnjs {
+
+namespace {
+constexpr char magic[8] = {'j', 'n', 'j', 's', 'b', 'c', '\0', '\0'};
+constexpr uint32_t format_version = 2;
+
+uint64_t fnv1a(uint64_t h, std::string_view s) {
+    for (const auto c : s) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::string entry_name(std::string_view source, const char *filename) {
+    auto h = fnv1a(0xcbf29ce484222325ULL, filename);
+    h = fnv1a(h ^ 0xff, source);
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%016llx.jsbc", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+template <typename T> void put(std::vector<uint8_t> &out, const T &v) {
+    const auto *p = reinterpret_cast<const uint8_t *>(&v);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T> bool take(const uint8_t *&p, const uint8_t *end, T &v) {
+    if (static_cast<size_t>(end - p) < sizeof(T))
+        return false;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+std::vector<uint8_t> read_file(const std::filesystem::path &p) {
+    std::ifstream f(p, std::ios::binary | std::ios::ate);
+    if (!f)
+        return {};
+    std::vector<uint8_t> ret(static_cast<size_t>(f.tellg()));
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char *>(ret.data()), static_cast<std::streamsize>(ret.size())))
+        return {};
+    return ret;
+}
+
+/**
+ * Check that a string stored in a cache entry matches.
+ */
+template <typename Size> bool take_equal(const uint8_t *&p, const uint8_t *end, std::string_view expected) {
+    Size size;
+    if (!take(p, end, size) || size != expected.size() || static_cast<size_t>(end - p) < size ||
+        std::memcmp(p, expected.data(), size) != 0)
+        return false;
+    p += size;
+    return true;
+}
+
+template <typename Size> void put_string(std::vector<uint8_t> &out, std::string_view s) {
+    put(out, static_cast<Size>(s.size()));
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+/**
+ * Find the bytecode in a cache entry.
+ * @note The full source and filename are stored and compared, so a colliding file name never loads the wrong script.
+ * @return Offset of the bytecode, or 0 if the entry was written by another version or for another source.
+ */
+size_t check_header(const std::vector<uint8_t> &data, std::string_view source, std::string_view filename) {
+    const auto *p = data.data();
+    const auto *end = p + data.size();
+    const std::string_view version = JS_GetVersion();
+    char m[sizeof(magic)];
+    uint32_t fmt;
+    if (!take(p, end, m) || std::memcmp(m, magic, sizeof(magic)) != 0)
+        return 0;
+    if (!take(p, end, fmt) || fmt != format_version)
+        return 0;
+    if (!take_equal<uint32_t>(p, end, version) || !take_equal<uint32_t>(p, end, filename) ||
+        !take_equal<uint64_t>(p, end, source))
+        return 0;
+    return p == end ? 0 : static_cast<size_t>(p - data.data());
+}
+
+} // namespace
+
+bytecode_cache::bytecode_cache(std::filesystem::path dir) : _dir(std::move(dir)) {
+    std::error_code ec;
+    std::filesystem::create_directories(_dir, ec);
+}
+
+script bytecode_cache::compile(context &ctx, std::string_view source, const char *filename) {
+    const auto path = _dir / entry_name(source, filename);
+
+    const auto data = read_file(path);
+    if (const auto off = check_header(data, source, filename); off != 0) {
+        auto s = ctx._load_script(data.data() + off, data.size() - off);
+        if (s.valid()) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return s;
+        }
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    auto s = ctx.compile(source, filename);
+    const auto bytecode = ctx._write_script(s);
+    if (!bytecode.empty()) {
+        const std::string_view version = JS_GetVersion();
+        const std::string_view name = filename;
+        std::vector<uint8_t> out;
+        out.reserve(sizeof(magic) + 24 + version.size() + name.size() + source.size() + bytecode.size());
+        out.insert(out.end(), magic, magic + sizeof(magic));
+        put(out, format_version);
+        put_string<uint32_t>(out, version);
+        put_string<uint32_t>(out, name);
+        put_string<uint64_t>(out, source);
+        out.insert(out.end(), bytecode.begin(), bytecode.end());
+        detail::write_file_atomic(path, out.data(), out.size());
+    }
+    return s;
+}
+
+} // namespace jnjs
@@ -1,34 +1,101 @@
 #include <quickjs.h>
 
+#include <string>
+
 #include <jnjs/context.h>
+#include <jnjs/detail/runtime_data.h>
+#include <jnjs/error.h>
 
 namespace jnjs {
 
 namespace detail {
 namespace {
-void install_rt_class(JSRuntime *rt, const class_builder_data &d, internal_class_meta_data &o) {
-    if (o.id != 0)
-        return;
-    JS_NewClassID(rt, &o.id);
-    JS_NewClass(rt, o.id, &d.def);
+JSClassID install_rt_class(JSRuntime *rt, const class_builder_data &d, const internal_class_meta_data &o) {
+    auto &rd = runtime_data::get(rt);
+    if (auto id = rd.class_id(o); id != 0)
+        return id;
+    JSClassID id = 0;
+    JS_NewClassID(rt, &id);
+    JS_NewClass(rt, id, &d.def);
+    if (rd.class_ids.size() <= o.index)
+        rd.class_ids.resize(o.index + 1, 0);
+    rd.class_ids[o.index] = id;
+    return id;
 }
 } // namespace
-} // namespace detail
 
-void context::_decl_class_impl(const detail::class_builder_data &d, detail::internal_class_meta_data &oid) {
-    auto *ctx = get();
-    detail::install_rt_class(JS_GetRuntime(ctx), d, oid);
+void declare_class(JSContext *ctx, const class_builder_data &d, const internal_class_meta_data &o,
+                   JSValueConst global) {
+    const auto id = install_rt_class(JS_GetRuntime(ctx), d, o);
 
     auto proto = JS_NewObject(ctx);
     JS_SetPropertyFunctionList(ctx, proto, d.fns, d.cur_fn);
 
-    if (d.ctor) {
+    if (d.array_like) {
+        // array methods and iteration only need length and indexed access, which the exotic methods provide
+        auto g = JS_GetGlobalObject(ctx);
+        auto array = JS_GetPropertyStr(ctx, g, "Array");
+        auto array_proto = JS_GetPropertyStr(ctx, array, "prototype");
+        JS_SetPrototype(ctx, proto, array_proto);
+        JS_FreeValue(ctx, array_proto);
+        JS_FreeValue(ctx, array);
+        JS_FreeValue(ctx, g);
+    }
+
+    if (d.ctor && JS_IsObject(global)) {
         JSValue ctor = JS_NewCFunction2(ctx, d.ctor, d.def.class_name, d.ctor_len, JS_CFUNC_constructor, 0);
         JS_SetConstructor(ctx, ctor, proto);
-        set_global(d.def.class_name, value(ctor, ctx));
+        JS_SetPropertyStr(ctx, global, d.def.class_name, ctor);
+    }
+
+    JS_SetClassProto(ctx, id, proto);
+}
+} // namespace detail
+
+script context::compile(std::string_view source, const char *filename) {
+    auto *ctx = get();
+    // the parser expects a null terminated buffer
+    const std::string code(source);
+    auto fn = JS_Eval(ctx, code.c_str(), code.size(), filename,
+                      JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY);
+    if (JS_IsException(fn))
+        throw detail::value_helpers<js_error>::as(ctx, fn);
+    return script(value(fn, ctx));
+}
+
+script context::_load_script(const uint8_t *data, size_t size) {
+    auto *ctx = get();
+    auto fn = JS_ReadObject(ctx, data, size, JS_READ_OBJ_BYTECODE);
+    if (JS_IsException(fn)) {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        return {};
     }
+    return script(value(fn, ctx));
+}
+
+std::vector<uint8_t> context::_write_script(const script &s) {
+    auto *ctx = get();
+    size_t len;
+    auto *buf = JS_WriteObject(ctx, &len, s._fn._v, JS_WRITE_OBJ_BYTECODE);
+    if (buf == nullptr) {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        return {};
+    }
+    std::vector<uint8_t> ret(buf, buf + len);
+    js_free(ctx, buf);
+    return ret;
+}
+
+void context::_decl_class_impl(const detail::class_builder_data &d, const detail::internal_class_meta_data &o) {
+    auto *ctx = get();
+    auto g = JS_GetGlobalObject(ctx);
+    _decl_class_impl(d, o, g);
+    JS_FreeValue(ctx, g);
+}
 
-    JS_SetClassProto(ctx, oid.id, proto);
+void context::_decl_class_impl(const detail::class_builder_data &d, const detail::internal_class_meta_data &o,
+                               JSValueConst global) {
+    detail::declare_class(get(), d, o, global);
 }
 
 } // namespace jnjs
\ No newline at end of file
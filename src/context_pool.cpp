@@ -0,0 +1,104 @@
+#include <jnjs/context_pool.h>
+
+#include <algorithm>
+
+namespace jnjs {
+
+struct context_pool::entry {
+    context ctx;
+    size_t uses = 0;
+    std::vector<JSAtom> globals; /**< Sorted global object property names after init, each holding a reference. */
+
+    explicit entry(context c) : ctx(std::move(c)) {}
+    ~entry() {
+        for (auto a : globals) {
+            JS_FreeAtom(ctx.get(), a);
+        }
+    }
+};
+
+namespace {
+std::vector<JSAtom> global_names(JSContext *ctx) {
+    std::vector<JSAtom> ret;
+    auto g = JS_GetGlobalObject(ctx);
+    JSPropertyEnum *tab;
+    uint32_t len;
+    if (JS_GetOwnPropertyNames(ctx, &tab, &len, g, JS_GPN_STRING_MASK | JS_GPN_SYMBOL_MASK) == 0) {
+        ret.reserve(len);
+        for (uint32_t i = 0; i < len; ++i) {
+            ret.push_back(tab[i].atom);
+        }
+        // the atoms are kept, only the table is freed
+        js_free(ctx, tab);
+    }
+    JS_FreeValue(ctx, g);
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+bool globals_changed(JSContext *ctx, const std::vector<JSAtom> &before) {
+    auto now = global_names(ctx);
+    const bool changed = now != before;
+    for (auto a : now) {
+        JS_FreeAtom(ctx, a);
+    }
+    return changed;
+}
+} // namespace
+
+context &context_pool::lease::operator*() const { return _e->ctx; }
+
+context_pool::context_pool(runtime &rt, size_t size, init_fn init) : context_pool(rt, size, std::move(init), {}) {}
+
+context_pool::context_pool(runtime &rt, size_t size, init_fn init, policy p)
+    : _rt(rt), _init(std::move(init)), _policy(p) {
+    _all.reserve(size);
+    _free.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        _all.emplace_back(_make_entry());
+        _free.push_back(_all.back().get());
+    }
+}
+
+context_pool::~context_pool() = default;
+
+std::unique_ptr<context_pool::entry> context_pool::_make_entry() {
+    auto e = std::make_unique<entry>(_rt.make_context());
+    if (_init) {
+        _init(e->ctx);
+    }
+    if (_policy.discard_on_global_change) {
+        e->globals = global_names(e->ctx.get());
+    }
+    return e;
+}
+
+context_pool::lease context_pool::acquire() {
+    if (_free.empty()) {
+        _all.emplace_back(_make_entry());
+        _free.push_back(_all.back().get());
+    }
+    auto *e = _free.back();
+    _free.pop_back();
+    ++e->uses;
+    return {this, e};
+}
+
+void context_pool::_release(entry *e) {
+    if (_policy.max_idle != 0 && _free.size() >= _policy.max_idle) {
+        auto it = std::find_if(_all.begin(), _all.end(), [e](const auto &p) { return p.get() == e; });
+        _all.erase(it);
+        return;
+    }
+    const bool worn_out = _policy.max_uses != 0 && e->uses >= _policy.max_uses;
+    if (worn_out || (_policy.discard_on_global_change && globals_changed(e->ctx.get(), e->globals))) {
+        auto it = std::find_if(_all.begin(), _all.end(), [e](const auto &p) { return p.get() == e; });
+        // release the old context before setting up its replacement
+        it->reset();
+        *it = _make_entry();
+        e = it->get();
+    }
+    _free.push_back(e);
+}
+
+} // namespace jnjs
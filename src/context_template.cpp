@@ -0,0 +1,74 @@
+#include <jnjs/context_template.h>
+#include <jnjs/error.h>
+
+#include <mutex>
+
+namespace jnjs {
+
+namespace {
+[[noreturn]] void throw_pending(JSContext *ctx) { throw detail::value_helpers<js_error>::as(ctx, JS_EXCEPTION); }
+} // namespace
+
+struct context_template::script {
+    std::string code;
+    std::string filename;
+    std::once_flag compiled;
+    std::vector<uint8_t> bytecode; /**< Written once under `compiled`, read-only afterwards. */
+
+    void run(JSContext *ctx);
+};
+
+void context_template::script::run(JSContext *ctx) {
+    JSValue fn = JS_UNDEFINED;
+    std::call_once(compiled, [&] {
+        fn = JS_Eval(ctx, code.data(), code.size(), filename.c_str(),
+                     JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY);
+        if (JS_IsException(fn))
+            throw_pending(ctx);
+        size_t len;
+        auto *buf = JS_WriteObject(ctx, &len, fn, JS_WRITE_OBJ_BYTECODE);
+        if (buf == nullptr) {
+            JS_FreeValue(ctx, fn);
+            throw_pending(ctx);
+        }
+        bytecode.assign(buf, buf + len);
+        js_free(ctx, buf);
+    });
+    // every context but the one that compiled the script loads the shared bytecode
+    if (JS_IsUndefined(fn)) {
+        fn = JS_ReadObject(ctx, bytecode.data(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+        if (JS_IsException(fn))
+            throw_pending(ctx);
+    }
+    const detail::run_scope running(ctx);
+    auto r = JS_EvalFunction(ctx, fn);
+    if (JS_IsException(r))
+        throw_pending(ctx);
+    JS_FreeValue(ctx, r);
+}
+
+context_template &context_template::eval(std::string code, std::string filename) {
+    auto s = std::make_shared<script>();
+    s->code = std::move(code);
+    s->filename = std::move(filename);
+    _scripts.push_back(std::move(s));
+    return *this;
+}
+
+void context_template::apply(context &c) const {
+    auto *ctx = c.get();
+    auto g = JS_GetGlobalObject(ctx);
+    for (const auto &s : _classes) {
+        c._decl_class_impl(*s.d, *s.o, g);
+    }
+    for (const auto &s : _globals) {
+        JS_SetPropertyStr(ctx, g, s.name.c_str(), s.make(ctx, s.name.c_str()));
+    }
+    JS_FreeValue(ctx, g);
+
+    for (const auto &s : _scripts) {
+        s->run(ctx);
+    }
+}
+
+} // namespace jnjs
@@ -3,13 +3,130 @@
 #include <jnjs/runtime.h>
 
 #include <jnjs/context.h>
+#include <jnjs/detail/runtime_data.h>
+#include <jnjs/serialized.h>
 
 namespace jnjs {
 
-namespace {} // namespace
+namespace {
+void interrupt(detail::runtime_data &d, detail::interrupt_frame *tripped, interrupt_reason r) {
+    d.last_interrupt = r;
+    for (auto *f = d.limit; f != nullptr; f = f->prev) {
+        f->reason = r;
+        if (f == tripped)
+            break;
+    }
+}
 
-runtime::runtime() : base(JS_NewRuntime(), JS_FreeRuntime) {}
+int interrupt_handler(JSRuntime *, void *opaque) {
+    auto &d = *static_cast<detail::runtime_data *>(opaque);
+    if (HEDLEY_UNLIKELY(d.terminate->load(std::memory_order_relaxed)) && d.terminate->exchange(false)) {
+        interrupt(d, nullptr, interrupt_reason::terminated);
+        return 1;
+    }
+    if (HEDLEY_LIKELY(d.limit == nullptr))
+        return 0;
 
-context runtime::_new_context() { return context(*get()); }
+    std::chrono::steady_clock::time_point now = {};
+    for (auto *f = d.limit; f != nullptr; f = f->prev) {
+        if (f->budget != UINT64_MAX) {
+            if (f->budget == 0) {
+                interrupt(d, f, interrupt_reason::budget);
+                return 1;
+            }
+            --f->budget;
+        }
+        if (f->deadline != std::chrono::steady_clock::time_point::max()) {
+            if (now == std::chrono::steady_clock::time_point{})
+                now = std::chrono::steady_clock::now();
+            if (now >= f->deadline) {
+                interrupt(d, f, interrupt_reason::deadline);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
 
-} // namespace jnjs
\ No newline at end of file
+JSRuntime *create_runtime(std::unique_ptr<allocator> alloc) {
+    auto d = std::make_unique<detail::runtime_data>();
+    JSRuntime *rt;
+    if (alloc) {
+        d->alloc = std::move(alloc);
+        rt = JS_NewRuntime2(&detail::allocator_malloc_functions(), d->alloc.get());
+    } else {
+        rt = JS_NewRuntime();
+    }
+    JS_SetInterruptHandler(rt, interrupt_handler, d.get());
+    JS_SetSharedArrayBufferFunctions(rt, &detail::shared_buffer_functions());
+    JS_SetRuntimeOpaque(rt, d.release());
+    return rt;
+}
+
+void destroy_runtime(JSRuntime *rt) {
+    // class finalizers still need the class ids while the runtime is torn down
+    auto *d = &detail::runtime_data::get(rt);
+    for (const auto a : d->atoms) {
+        if (a != JS_ATOM_NULL)
+            JS_FreeAtomRT(rt, a);
+    }
+    JS_FreeRuntime(rt);
+    delete d;
+}
+} // namespace
+
+runtime::runtime() : runtime(nullptr) {}
+
+runtime::runtime(std::unique_ptr<allocator> alloc) : base(create_runtime(std::move(alloc)), destroy_runtime) {}
+
+context runtime::make_context() { return context(*get()); }
+
+void runtime::set_bundle(std::shared_ptr<const bundle> b) {
+    auto *rt = get();
+    JS_SetModuleLoaderFunc(rt, nullptr, b ? &bundle::_load_module : nullptr, const_cast<bundle *>(b.get()));
+    detail::runtime_data::get(rt).modules = std::move(b);
+}
+
+execution_limit::execution_limit(context &ctx, const limits &l) : execution_limit(JS_GetRuntime(ctx.get()), l) {}
+
+execution_limit::execution_limit(runtime &rt, const limits &l) : execution_limit(rt.get(), l) {}
+
+void runtime::run_gc() {
+    JS_RunGC(get());
+    ++detail::runtime_data::get(get()).explicit_gc_runs;
+}
+
+memory_stats detail::compute_memory_stats(JSRuntime *rt) {
+    JSMemoryUsage u;
+    JS_ComputeMemoryUsage(rt, &u);
+    memory_stats r;
+    r.malloc_size = u.malloc_size;
+    r.malloc_limit = u.malloc_limit;
+    r.malloc_count = u.malloc_count;
+    r.memory_used_size = u.memory_used_size;
+    r.memory_used_count = u.memory_used_count;
+    r.atom_count = u.atom_count;
+    r.atom_size = u.atom_size;
+    r.str_count = u.str_count;
+    r.str_size = u.str_size;
+    r.obj_count = u.obj_count;
+    r.obj_size = u.obj_size;
+    r.prop_count = u.prop_count;
+    r.prop_size = u.prop_size;
+    r.shape_count = u.shape_count;
+    r.shape_size = u.shape_size;
+    r.js_func_count = u.js_func_count;
+    r.js_func_size = u.js_func_size;
+    r.js_func_code_size = u.js_func_code_size;
+    r.c_func_count = u.c_func_count;
+    r.array_count = u.array_count;
+    r.fast_array_count = u.fast_array_count;
+    r.fast_array_elements = u.fast_array_elements;
+    r.binary_object_count = u.binary_object_count;
+    r.binary_object_size = u.binary_object_size;
+    r.explicit_gc_runs = runtime_data::get(rt).explicit_gc_runs;
+    r.gc_threshold = JS_GetGCThreshold(rt);
+    return r;
+}
+
+} // namespace jnjs
@@ -0,0 +1,176 @@
+#include <jnjs/runtime_pool.h>
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace jnjs {
+
+struct runtime_pool::worker {
+    size_t index = 0;
+    std::mutex m;
+    std::deque<job> q;
+    std::promise<void> ready; /**< Set once init_fn ran, or to the exception it threw. */
+    std::thread thread;
+};
+
+namespace {
+/** A pooled_script compiled on one worker, kept while any handle to it is alive. */
+struct cached_script {
+    std::weak_ptr<const void> source;
+    script compiled;
+};
+
+/** State of the worker running on the current thread, so jobs can find it. */
+struct worker_state {
+    const runtime_pool *pool = nullptr;
+    context *ctx = nullptr;
+    std::unordered_map<size_t, cached_script> scripts; /**< Compiled pooled_scripts, by id. */
+};
+thread_local worker_state *tl_worker = nullptr;
+} // namespace
+
+runtime_pool::runtime_pool(size_t threads, init_fn init, allocator_fn alloc)
+    : _init(std::move(init)), _alloc(std::move(alloc)) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        auto w = std::make_unique<worker>();
+        w->index = i;
+        _workers.emplace_back(std::move(w));
+    }
+    // start the threads only once every worker exists, so they can steal from each other
+    for (auto &w : _workers) {
+        w->thread = std::thread([this, &w = *w] { _run(w); });
+    }
+
+    std::exception_ptr init_error;
+    for (auto &w : _workers) {
+        try {
+            w->ready.get_future().get();
+        } catch (...) {
+            if (!init_error)
+                init_error = std::current_exception();
+        }
+    }
+    if (HEDLEY_UNLIKELY(init_error)) {
+        _shutdown();
+        std::rethrow_exception(init_error);
+    }
+}
+
+runtime_pool::~runtime_pool() { _shutdown(); }
+
+void runtime_pool::_shutdown() {
+    {
+        std::lock_guard l(_sleep_m);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto &w : _workers) {
+        w->thread.join();
+    }
+}
+
+runtime_pool::pooled_script runtime_pool::compile(std::string code, std::string filename) {
+    const auto id = _next_script.fetch_add(1, std::memory_order_relaxed);
+    return pooled_script(std::make_shared<const pooled_script::source>(
+        pooled_script::source{id, std::move(code), std::move(filename)}));
+}
+
+const script &runtime_pool::_script_for(context &ctx, const pooled_script &s) {
+    if (HEDLEY_UNLIKELY(!s.valid()))
+        throw std::invalid_argument("running an empty pooled_script");
+    auto &scripts = tl_worker->scripts;
+    const auto &src = *s._source;
+    auto it = scripts.find(src.id);
+    if (it == scripts.end()) {
+        // compiling dwarfs a pass over the cache, so misses drop the scripts whose handles are all gone
+        std::erase_if(scripts, [](const auto &e) { return e.second.source.expired(); });
+        it = scripts.emplace(src.id, cached_script{s._source, ctx.compile(src.code, src.filename.c_str())}).first;
+    }
+    return it->second.compiled;
+}
+
+void runtime_pool::_push(job j) {
+    // a worker waiting on a job it queued for itself would wait forever, so run those right away
+    if (tl_worker != nullptr && tl_worker->pool == this) {
+        j(*tl_worker->ctx);
+        return;
+    }
+    auto &w = *_workers[_next.fetch_add(1, std::memory_order_relaxed) % _workers.size()];
+    {
+        // count the job before it becomes visible, so a fast thief can never take the count below zero
+        std::lock_guard l(_sleep_m);
+        _pending.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard l(w.m);
+        w.q.emplace_back(std::move(j));
+    }
+    _wake.notify_one();
+}
+
+bool runtime_pool::_pop(worker &w, job &out) {
+    std::lock_guard l(w.m);
+    if (w.q.empty())
+        return false;
+    out = std::move(w.q.front());
+    w.q.pop_front();
+    return true;
+}
+
+bool runtime_pool::_steal(const worker &w, job &out) {
+    const auto n = _workers.size();
+    for (size_t i = 1; i < n; ++i) {
+        auto &victim = *_workers[(w.index + i) % n];
+        std::lock_guard l(victim.m);
+        if (victim.q.empty())
+            continue;
+        out = std::move(victim.q.back());
+        victim.q.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void runtime_pool::_run(worker &w) {
+    runtime rt(_alloc ? _alloc() : nullptr);
+    auto ctx = rt.make_context();
+    // declared after the context, so compiled scripts are released before it
+    worker_state state{this, &ctx, {}};
+    tl_worker = &state;
+    try {
+        if (_init)
+            _init(ctx);
+        w.ready.set_value();
+    } catch (...) {
+        // the constructor stops the pool, so this worker never sees a job
+        w.ready.set_exception(std::current_exception());
+    }
+
+    job j;
+    while (true) {
+        if (_pop(w, j) || _steal(w, j)) {
+            _pending.fetch_sub(1, std::memory_order_acq_rel);
+            j(ctx);
+            j = nullptr;
+            continue;
+        }
+        std::unique_lock l(_sleep_m);
+        _wake.wait(l, [this] { return _stop || _pending.load(std::memory_order_acquire) > 0; });
+        if (_stop && _pending.load(std::memory_order_acquire) == 0)
+            break;
+    }
+
+    tl_worker = nullptr;
+}
+
+} // namespace jnjs
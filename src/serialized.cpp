@@ -0,0 +1,100 @@
+#include <jnjs/serialized.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <jnjs/context.h>
+#include <jnjs/error.h>
+#include <jnjs/value.h>
+
+namespace jnjs {
+
+namespace detail {
+namespace {
+// every shared buffer carries its reference count in front of it, so any runtime, or a message, can release it
+constexpr size_t sab_header_size = 16;
+static_assert(sizeof(std::atomic<size_t>) <= sab_header_size);
+
+std::atomic<size_t> &sab_refs(void *ptr) {
+    return *std::launder(reinterpret_cast<std::atomic<size_t> *>(static_cast<char *>(ptr) - sab_header_size));
+}
+
+void sab_dup(void *, void *ptr) { sab_refs(ptr).fetch_add(1, std::memory_order_relaxed); }
+
+void sab_free(void *, void *ptr) {
+    if (sab_refs(ptr).fetch_sub(1, std::memory_order_acq_rel) == 1)
+        std::free(static_cast<char *>(ptr) - sab_header_size);
+}
+
+void *sab_alloc(void *, size_t size) {
+    auto *p = static_cast<char *>(std::calloc(1, size + sab_header_size));
+    if (p == nullptr)
+        return nullptr;
+    new (p) std::atomic<size_t>(1);
+    return p + sab_header_size;
+}
+} // namespace
+
+const JSSharedArrayBufferFunctions &shared_buffer_functions() {
+    static const JSSharedArrayBufferFunctions fns = [] {
+        JSSharedArrayBufferFunctions f = {};
+        f.sab_alloc = sab_alloc;
+        f.sab_free = sab_free;
+        f.sab_dup = sab_dup;
+        return f;
+    }();
+    return fns;
+}
+} // namespace detail
+
+void serialized::_release() noexcept {
+    for (auto *p : _sabs) {
+        detail::sab_free(nullptr, p);
+    }
+    _sabs.clear();
+}
+
+void value::serialize(serialized &out, bool share_buffers) const {
+    out.clear();
+    if (HEDLEY_UNLIKELY(_ctx == nullptr))
+        return;
+
+    const int flags = JS_WRITE_OBJ_REFERENCE | (share_buffers ? JS_WRITE_OBJ_SAB : 0);
+    size_t len;
+    JSSABTab sabs = {};
+    auto *buf = JS_WriteObject2(_ctx, &len, _v, flags, &sabs);
+    if (buf == nullptr)
+        throw detail::value_helpers<js_error>::as(_ctx, JS_EXCEPTION);
+
+    try {
+        out._data.assign(buf, buf + len);
+        out._sabs.reserve(sabs.len);
+    } catch (...) {
+        js_free(_ctx, buf);
+        js_free(_ctx, sabs.tab);
+        throw;
+    }
+    // the message holds a reference to every buffer it passes through, until it is destroyed
+    for (size_t i = 0; i < sabs.len; ++i) {
+        detail::sab_dup(nullptr, sabs.tab[i]);
+        out._sabs.push_back(sabs.tab[i]);
+    }
+    js_free(_ctx, buf);
+    js_free(_ctx, sabs.tab);
+}
+
+value context::deserialize(const serialized &s) {
+    auto *ctx = get();
+    if (s.empty())
+        return value(JS_UNDEFINED, ctx);
+    const int flags = JS_READ_OBJ_REFERENCE | (s._sabs.empty() ? 0 : JS_READ_OBJ_SAB);
+    return value(JS_ReadObject(ctx, s._data.data(), s._data.size(), flags), ctx);
+}
+
+value context::deserialize(const uint8_t *data, size_t size) {
+    auto *ctx = get();
+    return value(JS_ReadObject(ctx, data, size, JS_READ_OBJ_REFERENCE), ctx);
+}
+
+} // namespace jnjs
@@ -0,0 +1,251 @@
+#include <jnjs/detail/simd.h>
+
+#include <cstring>
+
+#include <jnjs/detail/value_helpers.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JNJS_SIMD_X64 1
+#include <immintrin.h>
+#endif
+#if JNJS_SIMD_X64 && (defined(__GNUC__) || defined(__clang__))
+#define JNJS_SIMD_AVX2 1
+#define JNJS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace jnjs::detail::simd {
+
+namespace {
+// the vector kernels assume the plain 16 byte {union, int64 tag} layout, and not NaN boxing or checked values
+constexpr bool plain_layout = sizeof(JSValue) == 16;
+
+size_t unbox_int32_scalar(const JSValue *in, size_t n, int32_t *out) {
+    for (size_t i = 0; i < n; ++i) {
+        if (JS_VALUE_GET_TAG(in[i]) != JS_TAG_INT)
+            return i;
+        out[i] = JS_VALUE_GET_INT(in[i]);
+    }
+    return n;
+}
+
+size_t unbox_float64_scalar(const JSValue *in, size_t n, double *out) {
+    for (size_t i = 0; i < n; ++i) {
+        const auto tag = JS_VALUE_GET_TAG(in[i]);
+        if (tag == JS_TAG_INT)
+            out[i] = JS_VALUE_GET_INT(in[i]);
+        else if (JS_TAG_IS_FLOAT64(tag))
+            out[i] = JS_VALUE_GET_FLOAT64(in[i]);
+        else
+            return i;
+    }
+    return n;
+}
+
+void box_int32_scalar(const int32_t *in, size_t n, JSValue *out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = JS_MKVAL(JS_TAG_INT, in[i]);
+    }
+}
+
+// integral values become ints, so every conversion of a double agrees with value_helpers<double>::from
+void box_float64_scalar(const double *in, size_t n, JSValue *out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = value_helpers<double>::from(nullptr, in[i]);
+    }
+}
+
+#if JNJS_SIMD_X64
+// SSE2 is part of x86-64, so these need no dispatch
+size_t unbox_int32_sse2(const JSValue *in, size_t n, int32_t *out) {
+    const auto tag = _mm_set1_epi64x(JS_TAG_INT);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 1));
+        const auto tags = _mm_unpackhi_epi64(a, b);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(tags, tag)) != 0xffff)
+            break;
+        const auto vals = _mm_shuffle_epi32(_mm_unpacklo_epi64(a, b), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), vals);
+    }
+    return i + unbox_int32_scalar(in + i, n - i, out + i);
+}
+
+size_t unbox_float64_sse2(const JSValue *in, size_t n, double *out) {
+    const auto float_tag = _mm_set1_epi64x(JS_TAG_FLOAT64);
+    const auto int_tag = _mm_set1_epi64x(JS_TAG_INT);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 1));
+        const auto tags = _mm_unpackhi_epi64(a, b);
+        const auto vals = _mm_unpacklo_epi64(a, b);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(tags, float_tag)) == 0xffff) {
+            _mm_storeu_pd(out + i, _mm_castsi128_pd(vals));
+        } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(tags, int_tag)) == 0xffff) {
+            _mm_storeu_pd(out + i, _mm_cvtepi32_pd(_mm_shuffle_epi32(vals, _MM_SHUFFLE(2, 0, 2, 0))));
+        } else if (unbox_float64_scalar(in + i, 2, out + i) != 2) {
+            break;
+        }
+    }
+    return i + unbox_float64_scalar(in + i, n - i, out + i);
+}
+
+void box_int32_sse2(const int32_t *in, size_t n, JSValue *out) {
+    const auto tag = _mm_set1_epi64x(JS_TAG_INT);
+    const auto zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto lo = _mm_unpacklo_epi32(x, zero);
+        const auto hi = _mm_unpackhi_epi32(x, zero);
+        auto *o = reinterpret_cast<__m128i *>(out + i);
+        _mm_storeu_si128(o, _mm_unpacklo_epi64(lo, tag));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi64(lo, tag));
+        _mm_storeu_si128(o + 2, _mm_unpacklo_epi64(hi, tag));
+        _mm_storeu_si128(o + 3, _mm_unpackhi_epi64(hi, tag));
+    }
+    box_int32_scalar(in + i, n - i, out + i);
+}
+
+void box_float64_sse2(const double *in, size_t n, JSValue *out) {
+    const auto float_tag = _mm_set1_epi64x(JS_TAG_FLOAT64);
+    const auto int_tag = _mm_set1_epi64x(JS_TAG_INT);
+    const auto neg_zero = _mm_castpd_si128(_mm_set1_pd(-0.0));
+    const auto zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const auto d = _mm_loadu_pd(in + i);
+        const auto x = _mm_castpd_si128(d);
+        // out of range and NaN truncate to INT32_MIN, which then fails the round trip, except for INT32_MIN itself
+        const auto ints = _mm_cvttpd_epi32(d);
+        auto is_int = _mm_castpd_si128(_mm_cmpeq_pd(_mm_cvtepi32_pd(ints), d));
+        const auto nz32 = _mm_cmpeq_epi32(x, neg_zero);
+        is_int = _mm_andnot_si128(_mm_and_si128(nz32, _mm_shuffle_epi32(nz32, _MM_SHUFFLE(2, 3, 0, 1))), is_int);
+        const auto payload =
+            _mm_or_si128(_mm_and_si128(is_int, _mm_unpacklo_epi32(ints, zero)), _mm_andnot_si128(is_int, x));
+        const auto tags = _mm_or_si128(_mm_and_si128(is_int, int_tag), _mm_andnot_si128(is_int, float_tag));
+        auto *o = reinterpret_cast<__m128i *>(out + i);
+        _mm_storeu_si128(o, _mm_unpacklo_epi64(payload, tags));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi64(payload, tags));
+    }
+    box_float64_scalar(in + i, n - i, out + i);
+}
+#endif
+
+#if JNJS_SIMD_AVX2
+JNJS_TARGET_AVX2 size_t unbox_int32_avx2(const JSValue *in, size_t n, int32_t *out) {
+    const auto tag = _mm256_set1_epi64x(JS_TAG_INT);
+    const auto pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // a = [v0 | v1], b = [v2 | v3], one JSValue per 128 bit lane
+        const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 2));
+        const auto tags = _mm256_unpackhi_epi64(a, b);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(tags, tag)) != -1)
+            break;
+        // [u0, u2 | u1, u3] -> [u0, u1, u2, u3] -> low halves packed
+        const auto vals = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        const auto packed = _mm256_permutevar8x32_epi32(vals, pack);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_castsi256_si128(packed));
+    }
+    return i + unbox_int32_sse2(in + i, n - i, out + i);
+}
+
+JNJS_TARGET_AVX2 size_t unbox_float64_avx2(const JSValue *in, size_t n, double *out) {
+    const auto float_tag = _mm256_set1_epi64x(JS_TAG_FLOAT64);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 2));
+        const auto tags = _mm256_unpackhi_epi64(a, b);
+        // mixed runs are handled two at a time by the SSE2 kernel
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(tags, float_tag)) != -1)
+            break;
+        const auto vals = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_pd(out + i, _mm256_castsi256_pd(vals));
+    }
+    return i + unbox_float64_sse2(in + i, n - i, out + i);
+}
+
+JNJS_TARGET_AVX2 void box_int32_avx2(const int32_t *in, size_t n, JSValue *out) {
+    const auto tag = _mm256_set1_epi64x(JS_TAG_INT);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const auto x = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        // [u0, u1 | u2, u3] -> [u0, tag | u2, tag] and [u1, tag | u3, tag]
+        const auto lo = _mm256_unpacklo_epi64(x, tag);
+        const auto hi = _mm256_unpackhi_epi64(x, tag);
+        auto *o = reinterpret_cast<__m256i *>(out + i);
+        _mm256_storeu_si256(o, _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(o + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    box_int32_sse2(in + i, n - i, out + i);
+}
+
+JNJS_TARGET_AVX2 void box_float64_avx2(const double *in, size_t n, JSValue *out) {
+    const auto float_tag = _mm256_set1_epi64x(JS_TAG_FLOAT64);
+    const auto int_tag = _mm256_set1_epi64x(JS_TAG_INT);
+    const auto neg_zero = _mm256_castpd_si256(_mm256_set1_pd(-0.0));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const auto d = _mm256_loadu_pd(in + i);
+        const auto x = _mm256_castpd_si256(d);
+        // same narrowing as the SSE2 kernel, with real 64 bit compares and blends
+        const auto ints = _mm256_cvttpd_epi32(d);
+        auto is_int = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_cvtepi32_pd(ints), d, _CMP_EQ_OQ));
+        is_int = _mm256_andnot_si256(_mm256_cmpeq_epi64(x, neg_zero), is_int);
+        const auto payload = _mm256_blendv_epi8(x, _mm256_cvtepu32_epi64(ints), is_int);
+        const auto tags = _mm256_blendv_epi8(float_tag, int_tag, is_int);
+        const auto lo = _mm256_unpacklo_epi64(payload, tags);
+        const auto hi = _mm256_unpackhi_epi64(payload, tags);
+        auto *o = reinterpret_cast<__m256i *>(out + i);
+        _mm256_storeu_si256(o, _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(o + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    box_float64_sse2(in + i, n - i, out + i);
+}
+#endif
+
+/**
+ * Kernels picked once for the running CPU.
+ */
+struct kernels {
+    size_t (*unbox_int32)(const JSValue *, size_t, int32_t *) = unbox_int32_scalar;
+    size_t (*unbox_float64)(const JSValue *, size_t, double *) = unbox_float64_scalar;
+    void (*box_int32)(const int32_t *, size_t, JSValue *) = box_int32_scalar;
+    void (*box_float64)(const double *, size_t, JSValue *) = box_float64_scalar;
+
+    kernels() {
+        if constexpr (!plain_layout)
+            return;
+#if JNJS_SIMD_X64
+        unbox_int32 = unbox_int32_sse2;
+        unbox_float64 = unbox_float64_sse2;
+        box_int32 = box_int32_sse2;
+        box_float64 = box_float64_sse2;
+#endif
+#if JNJS_SIMD_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            unbox_int32 = unbox_int32_avx2;
+            unbox_float64 = unbox_float64_avx2;
+            box_int32 = box_int32_avx2;
+            box_float64 = box_float64_avx2;
+        }
+#endif
+    }
+};
+
+const kernels &active() {
+    static const kernels k;
+    return k;
+}
+} // namespace
+
+size_t unbox_int32(const JSValue *in, size_t n, int32_t *out) { return active().unbox_int32(in, n, out); }
+size_t unbox_float64(const JSValue *in, size_t n, double *out) { return active().unbox_float64(in, n, out); }
+void box_int32(const int32_t *in, size_t n, JSValue *out) { active().box_int32(in, n, out); }
+void box_float64(const double *in, size_t n, JSValue *out) { active().box_float64(in, n, out); }
+
+} // namespace jnjs::detail::simd
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <cstdlib>
+
+using namespace jnjs;
+
+namespace {
+
+struct counting_allocator final : allocator {
+    explicit counting_allocator(long &live_) : live(live_) {}
+
+    void *allocate(size_t size) override {
+        live += static_cast<long>(size);
+        return std::malloc(size);
+    }
+    void deallocate(void *p, size_t size) noexcept override {
+        live -= static_cast<long>(size);
+        std::free(p);
+    }
+
+    long &live;
+};
+
+const char *workload = "let o = []; for (let i = 0; i < 1000; i++) o.push({ i, s: 'v' + i }); "
+                       "o.map(v => v.s).join(',').length";
+
+} // namespace
+
+TEST_CASE("Pool allocator", "[allocator]") {
+    pool_allocator a;
+    auto *p1 = a.allocate(24);
+    a.deallocate(p1, 24);
+    // same size class comes straight back off the free list
+    auto *p2 = a.allocate(32);
+    REQUIRE(p1 == p2);
+    REQUIRE(a.reallocate(p2, 32, 20) == p2);
+    auto *big = a.allocate(4096);
+    REQUIRE(big != nullptr);
+    a.deallocate(big, 4096);
+    a.deallocate(p2, 20);
+}
+
+TEST_CASE("Arena allocator", "[allocator]") {
+    arena_allocator a(4096);
+    auto *p1 = a.allocate(16);
+    a.deallocate(p1, 16);
+    REQUIRE(a.allocate(16) == p1);
+    REQUIRE(a.reallocate(p1, 16, 64) == p1);
+    REQUIRE(a.reserved() == 4096);
+}
+
+TEST_CASE("Runtime allocators", "[allocator]") {
+    SECTION("pool") {
+        runtime rt(std::make_unique<pool_allocator>());
+        auto ctx = rt.make_context();
+        REQUIRE(ctx.eval(workload).as<int>() > 0);
+    }
+
+    SECTION("arena") {
+        runtime rt(std::make_unique<arena_allocator>());
+        auto ctx = rt.make_context();
+        REQUIRE(ctx.eval(workload).as<int>() > 0);
+    }
+
+    SECTION("custom") {
+        long live = 0;
+        {
+            runtime rt(std::make_unique<counting_allocator>(live));
+            auto ctx = rt.make_context();
+            REQUIRE(ctx.eval(workload).as<int>() > 0);
+            REQUIRE(live > 0);
+        }
+        REQUIRE(live == 0);
+    }
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <deque>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+std::vector<int> numbers = {1, 2, 3, 4};
+const std::deque<std::string> names = {"a", "b"};
+
+array_ref<std::vector<int>> get_numbers() { return array_ref(numbers); }
+array_ref<const std::deque<std::string>> get_names() { return array_ref(names); }
+size_t count(const array_ref<std::vector<int>> &r) { return r.size(); }
+
+struct ring {
+    size_t size() { return 5; }
+    int at(size_t i) { return static_cast<int>(i * i); }
+
+    constexpr static wrapped_class_builder<ring> build_js_class() {
+        wrapped_class_builder<ring> builder("ring");
+        builder.bind_indexer<&ring::size, &ring::at>();
+        return builder;
+    }
+};
+} // namespace
+
+TEST_CASE("Array references", "[array_ref]") {
+    auto ctx = runtime::new_context();
+    ctx.set_global_fn<get_numbers>("get_numbers");
+    ctx.set_global_fn<get_names>("get_names");
+    ctx.set_global_fn<count>("count");
+    numbers = {1, 2, 3, 4};
+
+    SECTION("reading") {
+        REQUIRE(ctx.eval("const n = get_numbers(); n.length === 4 && n[0] === 1 && n[3] === 4").as<bool>());
+        REQUIRE(ctx.eval("n[4] === undefined && n.foo === undefined").as<bool>());
+        REQUIRE(ctx.eval("n.map((x) => x * 2).join(',')").as<std::string>() == "2,4,6,8");
+        REQUIRE(ctx.eval("[...n].length") == 4);
+        REQUIRE(ctx.eval("Object.keys(n).join(',')").as<std::string>() == "0,1,2,3");
+        REQUIRE(ctx.eval("2 in n && !(4 in n)").as<bool>());
+        REQUIRE(ctx.eval("let s = 0; for (const x of n) s += x; s") == 10);
+        REQUIRE_FALSE(ctx.eval("Array.isArray(n)").as<bool>());
+    }
+
+    SECTION("no global constructor") {
+        ctx.eval("globalThis.ArrayRef = 1; const a = get_numbers(), b = get_names();");
+        REQUIRE(ctx.eval("ArrayRef") == 1);
+        REQUIRE(ctx.eval("a[0] === 1 && b.length === 2").as<bool>());
+        REQUIRE(ctx.eval("Object.getPrototypeOf(a) !== Object.getPrototypeOf(b)").as<bool>());
+        REQUIRE(ctx.eval("delete globalThis.ArrayRef; typeof ArrayRef").as<std::string>() == "undefined");
+    }
+
+    SECTION("by reference") {
+        ctx.eval("var n = get_numbers();");
+        numbers.push_back(5);
+        REQUIRE(ctx.eval("n.length === 5 && n[4] === 5").as<bool>());
+        ctx.eval("n[0] = 10;");
+        REQUIRE(numbers[0] == 10);
+        REQUIRE(ctx.eval("count(n)") == 5);
+        REQUIRE(ctx.eval("n").as<array_ref<std::vector<int>>>().size() == 5);
+    }
+
+    SECTION("read only and fixed size") {
+        REQUIRE(ctx.eval("const s = get_names(); s[1] === 'b'").as<bool>());
+        REQUIRE(ctx.eval("'use strict'; try { s[0] = 'x'; false } catch (e) { e instanceof TypeError }").as<bool>());
+        REQUIRE(names[0] == "a");
+        REQUIRE(ctx.eval("try { get_numbers().push(1); false } catch (e) { e instanceof TypeError }").as<bool>());
+        REQUIRE(numbers.size() == 4);
+    }
+
+    SECTION("shared containers and spans") {
+        auto shared = std::make_shared<std::vector<double>>(std::vector<double>{0.5, 1.5});
+        ctx.set_global("shared", array_ref(shared));
+        shared.reset();
+        REQUIRE(ctx.eval("shared[1] === 1.5").as<bool>());
+
+        int raw[3] = {7, 8, 9};
+        std::span<int> sp(raw);
+        ctx.set_global("sp", array_ref(sp));
+        ctx.eval("sp[2] = 0;");
+        REQUIRE(raw[2] == 0);
+        REQUIRE(ctx.eval("sp.reduce((a, b) => a + b)") == 15);
+    }
+
+    SECTION("custom indexers") {
+        ctx.install_class<ring>();
+        ring r;
+        ctx.set_global("r", &r);
+        REQUIRE(ctx.eval("r.length === 5 && r[3] === 9 && r.indexOf(16) === 4").as<bool>());
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <jnjs/jnjs.h>
 
+#include <numeric>
+
 #ifdef _MSC_VER
 #define noinline __declspec(noinline)
 #else
@@ -20,6 +22,9 @@ namespace {
 }
 
 #pragma optimize("", on)
+
+noinline size_t str_len(const std::string &s) { return s.size(); }
+noinline size_t view_len(std::string_view s) { return s.size(); }
 } // namespace
 
 TEST_CASE("Function benchmarks", "[benchmarks]") {
@@ -56,4 +61,264 @@ TEST_CASE("Function benchmarks", "[benchmarks]") {
         return sum;
     };
     BENCHMARK("add_f_js_c_n iters=" + std::to_string(iter_count)) { return f_js_c_n(iter_count).as<int>(); };
-}
\ No newline at end of file
+}
+TEST_CASE("Script benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    constexpr const char *rule = "var score = 0; for (var i = 0; i < 10; i++) { score += i * 2; } score > 50";
+    auto compiled = ctx.compile(rule);
+
+    BENCHMARK("eval") { return ctx.eval(rule).as<bool>(); };
+    BENCHMARK("compiled") { return compiled.run().as<bool>(); };
+}
+
+TEST_CASE("Property access benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto obj = ctx.eval("({ alpha: 1, beta: 2, gamma: 3 })");
+
+    BENCHMARK("by name") { return obj["alpha"].as<int>() + obj["beta"].as<int>() + obj["gamma"].as<int>(); };
+    BENCHMARK("by key") {
+        return obj[jnjs::key<"alpha">].as<int>() + obj[jnjs::key<"beta">].as<int>() +
+               obj[jnjs::key<"gamma">].as<int>();
+    };
+    BENCHMARK("get_many") {
+        auto [a, b, c] = obj.get_many(jnjs::key<"alpha">, jnjs::key<"beta">, jnjs::key<"gamma">);
+        return a.as<int>() + b.as<int>() + c.as<int>();
+    };
+}
+
+TEST_CASE("String argument benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<str_len>("str_len");
+    ctx.set_global_fn<view_len>("view_len");
+    auto f_str = ctx.eval("(s) => { let n = 0; for (let i = 0; i < 1000; i++) n += str_len(s); return n; }")
+                     .as<jnjs::function>();
+    auto f_view = ctx.eval("(s) => { let n = 0; for (let i = 0; i < 1000; i++) n += view_len(s); return n; }")
+                      .as<jnjs::function>();
+    const std::string arg(64, 'x');
+
+    BENCHMARK("std::string x1000") { return f_str(arg).as<int>(); };
+    BENCHMARK("std::string_view x1000") { return f_view(arg).as<int>(); };
+}
+
+TEST_CASE("String marshalling benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto length = ctx.eval("(s) => s.length").as<jnjs::function>();
+    auto number = ctx.eval("123456");
+    auto text = ctx.eval("'123456'");
+    const std::string ascii(256, 'x');
+    const std::string latin1(256, '\xe9');
+    const std::u16string utf16(256, u'\u20ac');
+
+    BENCHMARK("from ascii") { return length(ascii).as<int>(); };
+    BENCHMARK("from ascii latin1_view") { return length(jnjs::latin1_view{ascii}).as<int>(); };
+    BENCHMARK("from latin1_view") { return length(jnjs::latin1_view{latin1}).as<int>(); };
+    // what latin1_view used to do, widening to UTF-16 and storing two bytes per character
+    BENCHMARK("from latin1 widened to u16string") {
+        std::u16string wide(latin1.size(), u'\0');
+        for (size_t i = 0; i < latin1.size(); ++i) {
+            wide[i] = static_cast<uint8_t>(latin1[i]);
+        }
+        return length(wide).as<int>();
+    };
+    BENCHMARK("from u16string") { return length(utf16).as<int>(); };
+    BENCHMARK("int as std::string") { return number.as<std::string>(); };
+    BENCHMARK("string as std::string") { return text.as<std::string>(); };
+}
+
+namespace {
+double score(double a, double b, float w) { return a * w + b * (1 - w); }
+} // namespace
+
+TEST_CASE("Floating point benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<score>("score");
+    auto calls = ctx.eval("() => { let s = 0; for (let i = 0; i < 1000; ++i) s += score(i * 0.5, 1.25, 0.75); "
+                          "return s; }")
+                     .as<jnjs::function>();
+    auto blend = ctx.eval("(a, b) => a * 0.75 + b * 0.25").as<jnjs::function>();
+
+    BENCHMARK("double args x1000") { return calls().as<double>(); };
+    BENCHMARK("call with doubles") { return blend(1.5, 2.5).as<double>(); };
+}
+
+TEST_CASE("Vector benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto length = ctx.eval("(a) => a.length").as<jnjs::function>();
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+    const jnjs::typed_array<int32_t> typed(ints.begin(), ints.end());
+    auto js_array = ctx.eval("Array.from({ length: 100000 }, (_, i) => i)");
+    auto js_typed = ctx.eval("Int32Array.from({ length: 100000 }, (_, i) => i)");
+
+    BENCHMARK("vector to array 100k") { return length(ints).as<int>(); };
+    BENCHMARK("typed_array to Int32Array 100k") { return length(typed).as<int>(); };
+    BENCHMARK("array to vector 100k") { return js_array.as<std::vector<int>>().size(); };
+    BENCHMARK("Int32Array to vector 100k") { return js_typed.as<std::vector<int>>().size(); };
+}
+
+namespace {
+int sum_rest(const jnjs::remaining_args<int32_t> &args) { return std::accumulate(args.begin(), args.end(), 0); }
+} // namespace
+
+TEST_CASE("Numeric kernel benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<sum_rest>("sum_rest");
+    auto spread = ctx.eval("const a = Array.from({ length: 1000 }, (_, i) => i); () => sum_rest(...a)")
+                      .as<jnjs::function>();
+    std::vector<int32_t> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+    std::vector<JSValue> vals(ints.size());
+
+    BENCHMARK("remaining_args<int32_t> x1000") { return spread().as<int>(); };
+    BENCHMARK("box_int32 100k") {
+        jnjs::detail::simd::box_int32(ints.data(), ints.size(), vals.data());
+        return vals.back();
+    };
+    BENCHMARK("unbox_int32 100k") { return jnjs::detail::simd::unbox_int32(vals.data(), vals.size(), ints.data()); };
+}
+
+namespace {
+struct sample {
+    int id;
+    double score;
+    bool active;
+};
+JNJS_FIELDS(sample, id, score, active)
+} // namespace
+
+TEST_CASE("Aggregate benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto id = ctx.eval("(s) => s.id").as<jnjs::function>();
+    auto obj = ctx.eval("({ id: 1, score: 0.5, active: true })");
+    const sample s{1, 0.5, true};
+
+    BENCHMARK("struct to object") { return id(s).as<int>(); };
+    BENCHMARK("object to struct") { return obj.as<sample>().id; };
+}
+
+namespace {
+bool takes_value(const jnjs::value &v) { return v.is<jnjs::function>(); }
+bool takes_borrow(jnjs::borrowed_value v) { return v.is<jnjs::function>(); }
+} // namespace
+
+TEST_CASE("Borrowed value benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<takes_value>("takes_value");
+    ctx.set_global_fn<takes_borrow>("takes_borrow");
+    auto by_value = ctx.eval("const o = {}; () => { for (let i = 0; i < 1000; ++i) takes_value(o); }")
+                        .as<jnjs::function>();
+    auto by_borrow = ctx.eval("() => { for (let i = 0; i < 1000; ++i) takes_borrow(o); }").as<jnjs::function>();
+
+    BENCHMARK("value argument x1000") { return by_value(); };
+    BENCHMARK("borrowed_value argument x1000") { return by_borrow(); };
+}
+
+TEST_CASE("Value scope benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto items = ctx.eval("Array.from({ length: 1000 }, (_, i) => ({ price: i }))");
+
+    BENCHMARK("sum prices with values") {
+        int total = 0;
+        for (int i = 0; i < 1000; ++i) {
+            total += items[i][jnjs::key<"price">].as<int>();
+        }
+        return total;
+    };
+    BENCHMARK("sum prices in a value_scope") {
+        jnjs::value_scope scope(ctx, 2000);
+        int total = 0;
+        for (int i = 0; i < 1000; ++i) {
+            total += scope.get(scope.get(items, i), jnjs::key<"price">).as<int>();
+        }
+        return total;
+    };
+}
+
+TEST_CASE("Map benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    auto obj = ctx.eval("Object.fromEntries(Array.from({ length: 1000 }, (_, i) => ['key' + i, i]))");
+    const auto m = obj.as<std::unordered_map<std::string, int>>();
+    auto size = ctx.eval("(o) => Object.keys(o).length").as<jnjs::function>();
+
+    BENCHMARK("object to unordered_map 1k") { return obj.as<std::unordered_map<std::string, int>>().size(); };
+    BENCHMARK("object to map 1k") { return obj.as<std::map<std::string, int>>().size(); };
+    BENCHMARK("object to flat_map 1k") { return obj.as<jnjs::flat_map<std::string, int>>().size(); };
+    BENCHMARK("unordered_map to object 1k") { return size(m).as<int>(); };
+}
+
+namespace {
+int peek_vector(const std::vector<int> &v) { return v[v.size() / 2]; }
+int peek_view(const jnjs::array_view<int> &v) { return v[v.size() / 2]; }
+} // namespace
+
+TEST_CASE("View benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<peek_vector>("peek_vector");
+    ctx.set_global_fn<peek_view>("peek_view");
+    ctx.eval("var big = Array.from({ length: 100000 }, (_, i) => i);");
+    auto by_vector = ctx.eval("() => peek_vector(big)").as<jnjs::function>();
+    auto by_view = ctx.eval("() => peek_view(big)").as<jnjs::function>();
+
+    BENCHMARK("peek 100k array as vector") { return by_vector().as<int>(); };
+    BENCHMARK("peek 100k array as array_view") { return by_view().as<int>(); };
+}
+
+namespace {
+std::vector<int> dataset(100000, 1);
+std::vector<int> dataset_copy() { return dataset; }
+jnjs::array_ref<std::vector<int>> dataset_ref() { return jnjs::array_ref(dataset); }
+} // namespace
+
+TEST_CASE("Array reference benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    ctx.set_global_fn<dataset_copy>("dataset_copy");
+    ctx.set_global_fn<dataset_ref>("dataset_ref");
+    auto by_copy = ctx.eval("() => dataset_copy()[50000]").as<jnjs::function>();
+    auto by_ref = ctx.eval("() => dataset_ref()[50000]").as<jnjs::function>();
+    auto sum_ref = ctx.eval("() => { const d = dataset_ref(); let s = 0; for (let i = 0; i < 1000; ++i) s += d[i]; "
+                            "return s; }")
+                       .as<jnjs::function>();
+
+    BENCHMARK("read one of 100k copied") { return by_copy().as<int>(); };
+    BENCHMARK("read one of 100k by reference") { return by_ref().as<int>(); };
+    BENCHMARK("read 1000 by reference") { return sum_ref().as<int>(); };
+}
+
+TEST_CASE("JSON benchmarks", "[benchmarks]") {
+    auto ctx = jnjs::runtime::new_context();
+    std::string text = "[";
+    for (int i = 0; i < 1000; ++i) {
+        text += (i == 0 ? "" : ",") + std::string(R"({"id":)") + std::to_string(i) + R"(,"name":"item","ok":true})";
+    }
+    text += "]";
+    auto doc = ctx.parse_json(text);
+    auto stringify = ctx.eval("(v) => JSON.stringify(v)").as<jnjs::function>();
+    std::string out;
+
+    BENCHMARK("JSON.parse through eval") { return ctx.eval("JSON.parse('" + text + "')"); };
+    BENCHMARK("parse_json") { return ctx.parse_json(text); };
+    BENCHMARK("JSON.stringify to std::string") { return stringify(doc).as<std::string>(); };
+    BENCHMARK("to_json into reused buffer") {
+        out.clear();
+        return doc.to_json(out);
+    };
+}
+
+TEST_CASE("Serialization benchmarks", "[benchmarks]") {
+    jnjs::runtime other;
+    auto ctx = jnjs::runtime::new_context();
+    auto dest = other.make_context();
+    auto doc = ctx.eval("Array.from({length: 1000}, (_, i) => ({id: i, name: 'item', ok: true}))");
+    jnjs::serialized msg;
+    std::string json;
+
+    BENCHMARK("move through JSON") {
+        json.clear();
+        doc.to_json(json);
+        return dest.parse_json(json);
+    };
+    BENCHMARK("move through serialize") {
+        doc.serialize(msg);
+        return dest.deserialize(msg);
+    };
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <string>
+
+using namespace jnjs;
+
+namespace {
+bool is_fn(borrowed_value v) { return v.is<function>(); }
+int length(const borrowed_value &v) { return v["length"].as<int>(); }
+borrowed_value first(borrowed_value a, borrowed_value) { return a; }
+value keep(borrowed_value v) { return v.to_value(); }
+} // namespace
+
+TEST_CASE("Borrowed values", "[borrowed_value]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("borrowing a value") {
+        auto v = ctx.eval("({ a: 1, s: 'str' })");
+        {
+            borrowed_value b = v;
+            auto copy = b;
+            REQUIRE(b["a"] == 1);
+            REQUIRE(copy["s"].as<std::string>() == "str");
+            REQUIRE(b.is<value>());
+            REQUIRE_FALSE(b.is<int>());
+        }
+        // borrows ended, so the owner can go
+        v = ctx.eval("2");
+        borrowed_value b = v;
+        REQUIRE(b == 2);
+        REQUIRE(b.kinda_eq(std::string("2")));
+    }
+
+    SECTION("outliving the borrow with to_value") {
+        value kept;
+        {
+            auto v = ctx.eval("[1, 2, 3]");
+            kept = borrowed_value(v).to_value();
+        }
+        REQUIRE(kept["length"] == 3);
+        REQUIRE(borrowed_value().to_value().is<undefined>());
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<is_fn>("is_fn");
+        ctx.set_global_fn<length>("length");
+        ctx.set_global_fn<first>("first");
+        ctx.set_global_fn<keep>("keep");
+        REQUIRE(ctx.eval("is_fn(() => 1)") == true);
+        REQUIRE(ctx.eval("is_fn({})") == false);
+        REQUIRE(ctx.eval("length('abcd')") == 4);
+        REQUIRE(ctx.eval("const o = {}; first(o, 1) === o").as<bool>());
+        REQUIRE(ctx.eval("const k = [1]; keep(k) === k").as<bool>());
+    }
+}
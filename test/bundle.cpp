@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace jnjs;
+
+namespace {
+struct temp_file {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("jnjs_bundle_" + std::to_string(std::random_device{}()) + ".jsb");
+    ~temp_file() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+} // namespace
+
+TEST_CASE("Bundles", "[bundle]") {
+    temp_file file;
+    {
+        auto ctx = runtime::new_context();
+        bundle_writer w(ctx);
+        w.add_script("init.js", "globalThis.started = true; 40 + 2");
+        w.add_module("lib/math.mjs", "export const twice = (x) => x * 2;");
+        w.add_module("lib/main.mjs", "import { twice } from './math.mjs'; globalThis.result = twice(21);");
+        w.add_module("lib/chain.mjs",
+                     "import { twice } from './math.mjs'; export const quad = (x) => twice(twice(x));");
+        w.add_module("app.mjs", "import { quad } from './lib/chain.mjs'; globalThis.chained = quad(3);");
+        w.add_module("orphan.mjs", "import { nope } from './missing.mjs'; globalThis.orphan = true;");
+        REQUIRE_THROWS_AS(w.add_script("broken.js", "let = ;"), js_error);
+        REQUIRE(w.write(file.path));
+    }
+
+    auto b = std::make_shared<const bundle>(file.path);
+    REQUIRE(b->size() == 6);
+    REQUIRE(b->contains("lib/math.mjs"));
+    REQUIRE_FALSE(b->contains("broken.js"));
+
+    runtime rt;
+    rt.set_bundle(b);
+    auto ctx = rt.make_context();
+
+    SECTION("scripts") {
+        REQUIRE(b->run(ctx, "init.js") == 42);
+        REQUIRE(ctx.eval("started").as<bool>());
+    }
+
+    SECTION("modules and their imports") {
+        auto r = b->run(ctx, "lib/main.mjs");
+        REQUIRE_FALSE(r.is<js_error>());
+        REQUIRE(ctx.eval("result") == 42);
+    }
+
+    SECTION("entry modules importing other bundled modules") {
+        auto r = b->run(ctx, "app.mjs");
+        REQUIRE_FALSE(r.is<js_error>());
+        REQUIRE(ctx.eval("chained") == 12);
+    }
+
+    SECTION("unresolvable imports") {
+        REQUIRE(b->run(ctx, "orphan.mjs").is<js_error>());
+        REQUIRE(ctx.eval("typeof orphan") == std::string("undefined"));
+    }
+
+    SECTION("missing entries") {
+        REQUIRE(b->run(ctx, "nope.js").is<js_error>());
+    }
+
+    SECTION("not a bundle") {
+        temp_file other;
+        std::ofstream(other.path, std::ios::binary) << "definitely not a bundle file";
+        REQUIRE_THROWS_AS(bundle(other.path), std::runtime_error);
+        REQUIRE_THROWS_AS(bundle(other.path.string() + ".missing"), std::runtime_error);
+    }
+}
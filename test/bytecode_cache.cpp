@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace jnjs;
+
+namespace {
+struct temp_dir {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("jnjs_bytecode_cache_" + std::to_string(std::random_device{}()));
+    ~temp_dir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+} // namespace
+
+TEST_CASE("Bytecode cache", "[bytecode_cache]") {
+    temp_dir dir;
+    runtime rt;
+    auto ctx = rt.make_context();
+    constexpr const char *code = "var hits = (hits ?? 0) + 1; hits * 2";
+
+    SECTION("miss then hit") {
+        bytecode_cache cache(dir.path);
+        REQUIRE(cache.eval(ctx, code) == 2);
+        REQUIRE(cache.misses() == 1);
+
+        // a fresh cache on the same directory, as after a restart
+        bytecode_cache reopened(dir.path);
+        auto other = rt.make_context();
+        REQUIRE(reopened.eval(other, code) == 2);
+        REQUIRE(reopened.hits() == 1);
+        REQUIRE(reopened.misses() == 0);
+    }
+
+    SECTION("keyed by source and filename") {
+        bytecode_cache cache(dir.path);
+        cache.compile(ctx, code, "a.js");
+        cache.compile(ctx, code, "b.js");
+        cache.compile(ctx, "1 + 1", "a.js");
+        REQUIRE(cache.misses() == 3);
+        cache.compile(ctx, code, "a.js");
+        REQUIRE(cache.hits() == 1);
+    }
+
+    SECTION("damaged entries are recompiled") {
+        bytecode_cache cache(dir.path);
+        cache.compile(ctx, code);
+        for (const auto &e : std::filesystem::directory_iterator(dir.path)) {
+            std::ofstream(e.path(), std::ios::binary | std::ios::trunc) << "garbage";
+        }
+        REQUIRE(cache.eval(ctx, code) == 2);
+        REQUIRE(cache.misses() == 2);
+        REQUIRE(cache.eval(ctx, code) == 4);
+        REQUIRE(cache.hits() == 1);
+    }
+
+    SECTION("entries are checked against the full source") {
+        bytecode_cache cache(dir.path);
+        cache.compile(ctx, "1 + 1", "a.js");
+        const auto first = std::filesystem::directory_iterator(dir.path)->path();
+        cache.compile(ctx, "2 + 2", "a.js");
+        REQUIRE(cache.misses() == 2);
+        // make the second entry hold the first one's bytecode, as a colliding hash would
+        for (const auto &e : std::filesystem::directory_iterator(dir.path)) {
+            if (e.path() != first)
+                std::filesystem::copy_file(first, e.path(), std::filesystem::copy_options::overwrite_existing);
+        }
+        REQUIRE(cache.eval(ctx, "2 + 2", "a.js") == 4);
+        REQUIRE(cache.misses() == 3);
+        REQUIRE(cache.hits() == 0);
+    }
+
+    SECTION("parse errors are not cached") {
+        bytecode_cache cache(dir.path);
+        REQUIRE_THROWS_AS(cache.compile(ctx, "let = ;"), js_error);
+        REQUIRE(std::filesystem::is_empty(dir.path));
+    }
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+using namespace jnjs;
+
+TEST_CASE("Context pool", "[context_pool]") {
+    runtime rt;
+    int inits = 0;
+    auto init = [&inits](context &ctx) {
+        ++inits;
+        ctx.eval("globalThis.greeting = 'hello'");
+    };
+
+    SECTION("pre-warmed") {
+        context_pool pool(rt, 2, init);
+        REQUIRE(inits == 2);
+        REQUIRE(pool.available() == 2);
+        {
+            auto l = pool.acquire();
+            REQUIRE(pool.available() == 1);
+            REQUIRE(l->eval("greeting").as<std::string>() == "hello");
+        }
+        REQUIRE(pool.available() == 2);
+        REQUIRE(inits == 2);
+    }
+
+    SECTION("grows when empty") {
+        context_pool pool(rt, 1, init);
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        REQUIRE(inits == 2);
+        REQUIRE(pool.available() == 0);
+    }
+
+    SECTION("reuses clean contexts") {
+        context_pool pool(rt, 1, init);
+        {
+            auto l = pool.acquire();
+            l->eval("greeting = 'changed'");
+        }
+        auto l = pool.acquire();
+        // changing an existing global is not detected, only adding or removing one
+        REQUIRE(l->eval("greeting").as<std::string>() == "changed");
+        REQUIRE(inits == 1);
+    }
+
+    SECTION("discards contexts with new globals") {
+        context_pool pool(rt, 1, init);
+        {
+            auto l = pool.acquire();
+            l->eval("globalThis.leaked = 1");
+        }
+        REQUIRE(inits == 2);
+        auto l = pool.acquire();
+        REQUIRE(l->eval("typeof leaked").as<std::string>() == "undefined");
+    }
+
+    SECTION("max uses") {
+        context_pool pool(rt, 1, init, {.max_uses = 2, .discard_on_global_change = false});
+        for (int i = 0; i < 4; ++i) {
+            auto l = pool.acquire();
+            l->eval("globalThis.leaked = 1");
+        }
+        REQUIRE(inits == 3);
+    }
+
+    SECTION("max idle") {
+        context_pool pool(rt, 1, init, {.max_idle = 2});
+        {
+            auto a = pool.acquire();
+            auto b = pool.acquire();
+            auto c = pool.acquire();
+            REQUIRE(inits == 3);
+        }
+        REQUIRE(pool.available() == 2);
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        REQUIRE(inits == 3);
+    }
+
+    SECTION("grows for good without an idle cap") {
+        context_pool pool(rt, 1, init);
+        {
+            auto a = pool.acquire();
+            auto b = pool.acquire();
+        }
+        REQUIRE(pool.available() == 2);
+    }
+}
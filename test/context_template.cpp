@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <thread>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+
+int twice(int v) { return v * 2; }
+
+struct counter {
+    int n = 0;
+    int inc() { return ++n; }
+
+    constexpr static wrapped_class_builder<counter> build_js_class() {
+        wrapped_class_builder<counter> b("counter");
+        b.bind_ctor<>();
+        b.bind_function<&counter::inc>("inc");
+        return b;
+    }
+};
+
+context_template make_template() {
+    context_template tpl;
+    tpl.install_class<counter>()
+        .set_global_fn<&twice>("twice")
+        .set_global("answer", 42)
+        .eval("globalThis.bump = () => { const c = new counter(); c.inc(); return c.inc(); };");
+    return tpl;
+}
+
+} // namespace
+
+TEST_CASE("Context templates", "[context_template]") {
+    const auto tpl = make_template();
+    runtime rt;
+
+    SECTION("instantiate") {
+        auto ctx = tpl.instantiate(rt);
+        REQUIRE(ctx.eval("twice(answer)") == 84);
+        REQUIRE(ctx.eval("bump()") == 2);
+    }
+
+    SECTION("many contexts") {
+        std::vector<context> ctxs;
+        for (int i = 0; i < 8; ++i) {
+            ctxs.push_back(tpl.instantiate(rt));
+        }
+        ctxs[0].eval("globalThis.answer = 0");
+        REQUIRE(ctxs[0].eval("answer") == 0);
+        REQUIRE(ctxs[7].eval("answer") == 42);
+        REQUIRE(ctxs[7].eval("bump()") == 2);
+    }
+
+    SECTION("apply to an existing context") {
+        auto ctx = rt.make_context();
+        tpl.apply(ctx);
+        REQUIRE(ctx.eval("bump()") == 2);
+    }
+
+    SECTION("bootstrap errors") {
+        context_template bad;
+        bad.eval("throw new Error('boom')");
+        REQUIRE_THROWS_AS(bad.instantiate(rt), js_error);
+        context_template syntax;
+        syntax.eval("let = ;");
+        REQUIRE_THROWS_AS(syntax.instantiate(rt), js_error);
+        // the failed parse is not cached
+        REQUIRE_THROWS_AS(syntax.instantiate(rt), js_error);
+    }
+
+    SECTION("shared across runtimes and threads") {
+        std::vector<std::thread> threads;
+        std::vector<int> results(4);
+        for (size_t i = 0; i < results.size(); ++i) {
+            threads.emplace_back([&tpl, &results, i] {
+                runtime own;
+                auto ctx = tpl.instantiate(own);
+                results[i] = ctx.eval("bump() + twice(answer)").as<int>();
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        for (auto r : results) {
+            REQUIRE(r == 86);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace jnjs;
+
+namespace shapes {
+struct point {
+    int x = 0;
+    int y = 0;
+    bool operator==(const point &) const = default;
+};
+JNJS_FIELDS(point, x, y)
+
+struct polygon {
+    std::string name;
+    std::vector<point> points;
+    std::optional<double> area;
+    int sides = -1;
+
+    // fields can be declared inside the type too
+    friend JNJS_FIELDS(polygon, name, points, area)
+};
+} // namespace shapes
+
+namespace {
+shapes::point flip(const shapes::point &p) { return {p.y, p.x}; }
+} // namespace
+
+TEST_CASE("Aggregate conversion", "[fields]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("to js") {
+        ctx.set_global("p", shapes::point{1, 2});
+        REQUIRE(ctx.eval("p.x === 1 && p.y === 2").as<bool>());
+        REQUIRE(ctx.eval("Object.keys(p).join(',')").as<std::string>() == "x,y");
+    }
+
+    SECTION("from js") {
+        REQUIRE(ctx.eval("({ x: 3, y: 4 })").as<shapes::point>() == shapes::point{3, 4});
+        // missing properties keep their defaults
+        REQUIRE(ctx.eval("({ y: 5 })").as<shapes::point>() == shapes::point{0, 5});
+        REQUIRE(ctx.eval("({ x: 1 })").is<shapes::point>());
+        REQUIRE_FALSE(ctx.eval("1").is<shapes::point>());
+    }
+
+    SECTION("throwing getters") {
+        auto v = ctx.eval("({ x: 1, get y() { throw new RangeError('nope'); } })");
+        REQUIRE_THROWS_AS(v.as<shapes::point>(), js_error);
+        // nothing is left pending
+        REQUIRE(ctx.eval("1 + 1") == 2);
+    }
+
+    SECTION("nested") {
+        auto poly = ctx.eval("({ name: 'tri', points: [{ x: 0, y: 0 }, { x: 1, y: 0 }, { x: 0, y: 1 }], sides: 3 })")
+                        .as<shapes::polygon>();
+        REQUIRE(poly.name == "tri");
+        REQUIRE(poly.points.size() == 3);
+        REQUIRE(poly.points[2] == shapes::point{0, 1});
+        REQUIRE(poly.area == std::nullopt);
+        // not a declared field
+        REQUIRE(poly.sides == -1);
+
+        poly.area = 0.5;
+        ctx.set_global("poly", poly);
+        REQUIRE(ctx.eval("poly.points[1].x === 1 && poly.area === 0.5 && !('sides' in poly)").as<bool>());
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<flip>("flip");
+        REQUIRE(ctx.eval("const f = flip({ x: 1, y: 2 }); f.x === 2 && f.y === 1").as<bool>());
+    }
+}
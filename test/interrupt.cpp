@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace jnjs;
+using namespace std::chrono_literals;
+
+TEST_CASE("Execution limits", "[interrupt]") {
+    runtime rt;
+    auto ctx = rt.make_context();
+
+    SECTION("deadline") {
+        execution_limit limit(ctx, {.timeout = 20ms});
+        auto r = ctx.eval("while (true) {}");
+        REQUIRE(limit.reason() == interrupt_reason::deadline);
+        REQUIRE(r.is<interrupted_error>());
+        REQUIRE(r.as<interrupted_error>().reason() == interrupt_reason::deadline);
+    }
+
+    SECTION("budget") {
+        execution_limit limit(ctx, {.budget = 10});
+        auto r = ctx.eval("for (;;) {}");
+        REQUIRE(limit.reason() == interrupt_reason::budget);
+    }
+
+    SECTION("function call") {
+        auto fn = ctx.eval("() => { try { for (;;) {} } catch (e) { return 1; } }").as<function>();
+        execution_limit limit(ctx, {.timeout = 20ms});
+        auto r = fn();
+        // the interrupt can not be caught by the script
+        REQUIRE(limit.interrupted());
+        REQUIRE_FALSE(r.is<int>());
+    }
+
+    SECTION("not interrupted") {
+        execution_limit limit(ctx, {.timeout = 10s, .budget = 1000000});
+        REQUIRE(ctx.eval("let s = 0; for (let i = 0; i < 1000; i++) s += i; s") == 499500);
+        REQUIRE_FALSE(limit.interrupted());
+    }
+
+    SECTION("terminate from another thread") {
+        auto handle = rt.terminator();
+        // the deadline is only a backstop, a request made before eval starts is dropped and retried
+        execution_limit limit(ctx, {.timeout = 30s});
+        std::atomic<bool> done = false;
+        std::thread t([handle, &done] {
+            while (!done.load()) {
+                std::this_thread::sleep_for(20ms);
+                handle.terminate();
+            }
+        });
+        auto r = ctx.eval("while (true) {}");
+        done = true;
+        t.join();
+        REQUIRE(limit.reason() == interrupt_reason::terminated);
+    }
+
+    SECTION("unconverted interrupt") {
+        {
+            execution_limit limit(ctx, {.budget = 10});
+            auto r = ctx.eval("for (;;) {}");
+            REQUIRE(limit.interrupted());
+        }
+        auto r = ctx.eval("null.x");
+        REQUIRE(r.is<js_error>());
+        REQUIRE_FALSE(r.is<interrupted_error>());
+    }
+
+    SECTION("terminate while idle") {
+        auto handle = rt.terminator();
+        handle.terminate();
+        execution_limit limit(ctx);
+        REQUIRE(ctx.eval("let s = 0; for (let i = 0; i < 100000; i++) s += i; s") == 4999950000.0);
+        REQUIRE_FALSE(limit.interrupted());
+    }
+
+    // the context keeps working after an interrupt
+    REQUIRE(ctx.eval("1 + 1") == 2);
+}
+
+TEST_CASE("Pool job interrupt", "[interrupt]") {
+    runtime_pool pool(1);
+    auto f = pool.submit([](context &ctx) {
+        execution_limit limit(ctx, {.timeout = 10ms});
+        auto r = ctx.eval("for (;;) {}");
+        if (r.is<interrupted_error>()) {
+            throw r.as<interrupted_error>();
+        }
+        return r.as<int>();
+    });
+    REQUIRE_THROWS_AS(f.get(), interrupted_error);
+}
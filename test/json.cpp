@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace jnjs;
+
+TEST_CASE("JSON", "[json]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("parse") {
+        auto v = ctx.parse_json(R"({"a": 1, "b": [true, null, "x"], "c": {"d": 1.5}})");
+        REQUIRE(v["a"] == 1);
+        REQUIRE(v["b"][0] == true);
+        REQUIRE(v["b"][1].is<null>());
+        REQUIRE(v["b"][2] == std::string("x"));
+        REQUIRE(v["c"]["d"] == 1.5);
+
+        const std::string s = "[1, 2, 3]";
+        REQUIRE(ctx.parse_json(s).as<std::vector<int>>() == std::vector<int>{1, 2, 3});
+    }
+
+    SECTION("parse views without a terminator") {
+        const std::string_view text = "[1, 2]garbage";
+        REQUIRE(ctx.parse_json(text.substr(0, 6)).as<std::vector<int>>() == std::vector<int>{1, 2});
+    }
+
+    SECTION("parse errors") {
+        auto v = ctx.parse_json("{\"a\": }");
+        REQUIRE(v.is<js_error>());
+        REQUIRE(std::string(v.as<js_error>().what()).find("SyntaxError") != std::string::npos);
+        REQUIRE(ctx.eval("1 + 1") == 2);
+    }
+
+    SECTION("stringify") {
+        auto v = ctx.eval("({a: 1, b: [true, null, 'x'], f() {}, u: undefined})");
+        REQUIRE(v.to_json() == R"({"a":1,"b":[true,null,"x"]})");
+        REQUIRE(v["b"].to_json(2) == "[\n  true,\n  null,\n  \"x\"\n]");
+        // any integral indent picks the std::string overload, not a sink
+        REQUIRE(v["b"].to_json(2u) == v["b"].to_json(2));
+        REQUIRE(v["b"].to_json(size_t{2}) == v["b"].to_json(2));
+        REQUIRE(v["b"].to_json(2L) == v["b"].to_json(2));
+        REQUIRE(ctx.eval("'quo\"te'").to_json() == R"("quo\"te")");
+    }
+
+    SECTION("round trip") {
+        const std::string text = R"({"name":"jnjs","tags":["a","b"],"n":-0.25})";
+        REQUIRE(ctx.parse_json(text).to_json() == text);
+    }
+
+    SECTION("sinks") {
+        auto v = ctx.eval("({a: [1, 2]})");
+
+        std::string appended = "json: ";
+        REQUIRE(v.to_json(appended));
+        REQUIRE(appended == R"(json: {"a":[1,2]})");
+
+        std::vector<char> buf;
+        REQUIRE(v.to_json(buf));
+        REQUIRE(std::string_view(buf.data(), buf.size()) == R"({"a":[1,2]})");
+
+        std::ostringstream os;
+        REQUIRE(v.to_json(os));
+        REQUIRE(os.str() == R"({"a":[1,2]})");
+
+        size_t calls = 0;
+        size_t length = 0;
+        REQUIRE(v.to_json([&](std::string_view s) {
+            ++calls;
+            length += s.size();
+        }));
+        REQUIRE(calls == 1);
+        REQUIRE(length == 11);
+    }
+
+    SECTION("values without a representation") {
+        std::string out;
+        REQUIRE_FALSE(ctx.eval("undefined").to_json(out));
+        REQUIRE_FALSE(ctx.eval("(function() {})").to_json(out));
+        REQUIRE_FALSE(value().to_json(out));
+        REQUIRE(out.empty());
+        REQUIRE(ctx.eval("undefined").to_json().empty());
+    }
+
+    SECTION("stringify errors") {
+        REQUIRE_THROWS_AS(ctx.eval("const o = {}; o.self = o; o").to_json(), js_error);
+        REQUIRE_THROWS_AS(ctx.eval("({n: 1n})").to_json(), js_error);
+        REQUIRE_THROWS_AS(ctx.eval("({toJSON() { throw new Error('nope'); }})").to_json(), js_error);
+        REQUIRE(ctx.eval("1 + 1") == 2);
+    }
+}
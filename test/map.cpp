@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace jnjs;
+
+namespace {
+struct string_hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+using lookup_map = std::unordered_map<std::string, int, string_hash, std::equal_to<>>;
+
+int lookup(const lookup_map &m, std::string_view k) {
+    auto it = m.find(k);
+    return it == m.end() ? -1 : it->second;
+}
+} // namespace
+
+TEST_CASE("Map conversion", "[map]") {
+    auto ctx = runtime::new_context();
+    auto obj = ctx.eval("({ b: 2, a: 1, c: 3, [Symbol('s')]: 4 })");
+    auto keys = ctx.eval("(o) => Object.keys(o).join(',')").as<function>();
+
+    SECTION("unordered_map") {
+        auto m = obj.as<std::unordered_map<std::string, int>>();
+        // symbols are skipped
+        REQUIRE(m.size() == 3);
+        REQUIRE(m.at("b") == 2);
+        REQUIRE(keys(m).as<std::string>().size() == 5);
+
+        ctx.set_global_fn<lookup>("lookup");
+        REQUIRE(ctx.eval("lookup({ x: 7 }, 'x')") == 7);
+        REQUIRE(ctx.eval("lookup({ x: 7 }, 'y')") == -1);
+    }
+
+    SECTION("map") {
+        auto m = obj.as<std::map<std::string, int>>();
+        REQUIRE(m == std::map<std::string, int>{{"a", 1}, {"b", 2}, {"c", 3}});
+        REQUIRE(keys(m).as<std::string>() == "a,b,c");
+    }
+
+    SECTION("flat_map") {
+        auto m = obj.as<flat_map<std::string, int>>();
+        REQUIRE(m.size() == 3);
+        REQUIRE(m.front().first == "a");
+        REQUIRE(m.at(std::string_view("c")) == 3);
+        REQUIRE_FALSE(m.contains("d"));
+        REQUIRE(m.emplace("d", 4).second);
+        REQUIRE_FALSE(m.emplace("a", 5).second);
+        REQUIRE(keys(m).as<std::string>() == "a,b,c,d");
+
+        const flat_map<std::string, int> lit = {{"z", 1}, {"y", 2}, {"z", 3}};
+        REQUIRE(lit.size() == 2);
+        REQUIRE(lit.at("z") == 1);
+    }
+
+    SECTION("integer keys") {
+        const std::map<int, std::string> m = {{2, "two"}, {10, "ten"}, {-1, "minus"}};
+        ctx.set_global("m", m);
+        REQUIRE(ctx.eval("m[2] === 'two' && m[10] === 'ten' && m['-1'] === 'minus'").as<bool>());
+        REQUIRE(ctx.eval("m").as<std::map<int, std::string>>() == m);
+    }
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+double scale(double x, float f) { return x * f; }
+double mean(const remaining_args<double> &args) {
+    return std::accumulate(args.begin(), args.end(), 0.0) / static_cast<double>(args.size());
+}
+} // namespace
+
+TEST_CASE("Floating point conversion", "[number]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("from js") {
+        REQUIRE(ctx.eval("1.5").as<double>() == 1.5);
+        REQUIRE(ctx.eval("3").as<double>() == 3);
+        REQUIRE(ctx.eval("0.25").as<float>() == 0.25f);
+        REQUIRE(ctx.eval("'2.5'").as<double>() == 2.5);
+        REQUIRE(ctx.eval("true").as<double>() == 1);
+        REQUIRE(ctx.eval("null").as<double>() == 0);
+        REQUIRE(std::isnan(ctx.eval("undefined").as<double>()));
+        REQUIRE(ctx.eval("1.5") == 1.5);
+        REQUIRE(ctx.eval("7").is<double>());
+        REQUIRE_FALSE(ctx.eval("'7'").is<double>());
+    }
+
+    SECTION("to js") {
+        ctx.set_global("half", 0.5);
+        ctx.set_global("two", 2.0);
+        ctx.set_global("neg_zero", -0.0);
+        REQUIRE(ctx.eval("half === 0.5").as<bool>());
+        // integral values become ints
+        REQUIRE(ctx.get_global("two") == 2);
+        REQUIRE(ctx.eval("Object.is(neg_zero, -0)").as<bool>());
+        ctx.set_global("nan", std::nan(""));
+        REQUIRE(ctx.eval("Number.isNaN(nan)").as<bool>());
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<scale>("scale");
+        REQUIRE(ctx.eval("scale(1.5, 2)") == 3);
+        REQUIRE(ctx.eval("scale(0.5, 0.5)") == 0.25);
+        ctx.set_global_fn<mean>("mean");
+        REQUIRE(ctx.eval("mean(1, 2.5, 4, 0.5)") == 2);
+        REQUIRE(ctx.eval("mean(1, '2', 3)") == 2);
+    }
+
+    SECTION("vectors") {
+        const std::vector<double> v = {0.5, 1, -2.25};
+        ctx.set_global("v", v);
+        REQUIRE(ctx.eval("v.join(',')").as<std::string>() == "0.5,1,-2.25");
+        REQUIRE(ctx.eval("v").as<std::vector<double>>() == v);
+    }
+}
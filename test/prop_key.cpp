@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <string>
+
+using namespace jnjs;
+
+namespace {
+const prop_key runtime_key("b");
+} // namespace
+
+TEST_CASE("Property keys", "[prop_key]") {
+    auto ctx = runtime::new_context();
+    value v = ctx.eval("({ a: 1, b: 2, 3: 'three', nested: { c: true } })");
+
+    SECTION("get") {
+        REQUIRE(v[key<"a">] == 1);
+        REQUIRE(v[runtime_key] == 2);
+        REQUIRE(v[key<"3">].as<std::string>() == "three");
+        REQUIRE(v[key<"nested">][key<"c">].as<bool>());
+        REQUIRE(v[key<"missing">].is<undefined>());
+    }
+
+    SECTION("same key across objects") {
+        value other = ctx.eval("({ a: 10 })");
+        REQUIRE(v[key<"a">] == 1);
+        REQUIRE(other[key<"a">] == 10);
+    }
+
+    SECTION("set and has") {
+        REQUIRE_FALSE(v.has(key<"d">));
+        REQUIRE(v.set(key<"d">, 4));
+        REQUIRE(v.has(key<"d">));
+        REQUIRE(v[key<"d">] == 4);
+        REQUIRE(v.has(key<"toString">));
+    }
+
+    SECTION("failed set") {
+        value guarded = ctx.eval("Object.freeze({ set s(x) { throw new Error('no'); } })");
+        const auto before = ctx.memory_usage().obj_count;
+        REQUIRE_FALSE(guarded.set(key<"s">, 1));
+        REQUIRE_FALSE(guarded.set(key<"frozen">, 1));
+        // the thrown errors are not left pending on the context
+        REQUIRE(ctx.memory_usage().obj_count == before);
+        REQUIRE(ctx.eval("1 + 1") == 2);
+    }
+
+    SECTION("get_many") {
+        auto [a, b, missing] = v.get_many(key<"a">, runtime_key, key<"missing">);
+        REQUIRE(a == 1);
+        REQUIRE(b == 2);
+        REQUIRE(missing.is<undefined>());
+    }
+
+    SECTION("keys in several runtimes") {
+        runtime rt;
+        auto other = rt.make_context();
+        value o = other.eval("({ a: 'other' })");
+        REQUIRE(o[key<"a">].as<std::string>() == "other");
+        REQUIRE(v[key<"a">] == 1);
+    }
+
+    SECTION("empty value") {
+        value empty;
+        REQUIRE(empty[key<"a">].is<undefined>());
+        REQUIRE_FALSE(empty.has(key<"a">));
+    }
+}
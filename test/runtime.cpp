@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <thread>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+
+struct first_class {
+    int get() { return 1; }
+
+    constexpr static wrapped_class_builder<first_class> build_js_class() {
+        wrapped_class_builder<first_class> b("first_class");
+        b.bind_ctor<>();
+        b.bind_function<&first_class::get>("get");
+        return b;
+    }
+};
+
+struct second_class {
+    int get() { return 2; }
+
+    constexpr static wrapped_class_builder<second_class> build_js_class() {
+        wrapped_class_builder<second_class> b("second_class");
+        b.bind_ctor<>();
+        b.bind_function<&second_class::get>("get");
+        return b;
+    }
+};
+
+int triple(int v) { return v * 3; }
+
+} // namespace
+
+TEST_CASE("Independent runtimes", "[runtime]") {
+    runtime rt1;
+    runtime rt2;
+    auto ctx1 = rt1.make_context();
+    auto ctx2 = rt2.make_context();
+
+    // install in opposite orders so the runtimes hand out different class ids
+    ctx1.install_class<first_class>();
+    ctx1.install_class<second_class>();
+    ctx2.install_class<second_class>();
+    ctx2.install_class<first_class>();
+
+    REQUIRE(ctx1.eval("new first_class().get()") == 1);
+    REQUIRE(ctx1.eval("new second_class().get()") == 2);
+    REQUIRE(ctx2.eval("new first_class().get()") == 1);
+    REQUIRE(ctx2.eval("new second_class().get()") == 2);
+
+    first_class f;
+    ctx2.set_global("f", &f);
+    REQUIRE(ctx2.eval("f.get()") == 1);
+}
+
+TEST_CASE("Runtime move", "[runtime]") {
+    runtime rt1;
+    runtime rt2 = std::move(rt1);
+    auto ctx = rt2.make_context();
+    ctx.install_class<first_class>();
+    REQUIRE(ctx.eval("new first_class().get()") == 1);
+}
+
+TEST_CASE("Runtime per thread", "[runtime]") {
+    constexpr int thread_count = 4;
+    std::vector<int> results(thread_count);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i) {
+        threads.emplace_back([i, &results] {
+            runtime rt;
+            auto ctx = rt.make_context();
+            ctx.install_class<second_class>();
+            ctx.set_global_fn<triple>("triple");
+            results[i] = ctx.eval("let s = 0; for (let j = 0; j < 1000; j++) s += new second_class().get(); "
+                                  "triple(s)")
+                             .as<int>();
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (auto r : results) {
+        REQUIRE(r == 6000);
+    }
+}
+
+TEST_CASE("Memory usage", "[runtime]") {
+    runtime rt;
+    auto ctx = rt.make_context();
+    const auto before = rt.memory_usage();
+    REQUIRE(before.malloc_size > 0);
+    REQUIRE(before.obj_count > 0);
+
+    auto held = ctx.eval("const held = []; for (let i = 0; i < 1000; i++) held.push({ i }); held");
+    const auto after = rt.memory_usage();
+    REQUIRE(after.obj_count >= before.obj_count + 1000);
+    REQUIRE(ctx.memory_usage().obj_count == after.obj_count);
+
+    rt.run_gc();
+    REQUIRE(rt.memory_usage().explicit_gc_runs == 1);
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+
+struct counter {
+    int n = 0;
+    int next() { return ++n; }
+
+    constexpr static wrapped_class_builder<counter> build_js_class() {
+        wrapped_class_builder<counter> b("counter");
+        b.bind_ctor<>();
+        b.bind_function<&counter::next>("next");
+        return b;
+    }
+};
+
+int add(int a, int b) { return a + b; }
+
+} // namespace
+
+TEST_CASE("Runtime pool", "[runtime_pool]") {
+    runtime_pool pool(4, [](context &ctx) {
+        ctx.install_class<counter>();
+        ctx.set_global_fn<add>("add");
+        ctx.eval("function twice(v) { const c = new counter(); c.next(); return add(v, v) + c.next() - 2; }");
+    });
+    REQUIRE(pool.size() == 4);
+
+    SECTION("call") {
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.emplace_back(pool.call<int>("twice", i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(results[i].get() == i * 2);
+        }
+    }
+
+    SECTION("eval") {
+        REQUIRE(pool.eval<int>("add(20, 22)").get() == 42);
+        REQUIRE(pool.eval<std::string>("'a' + 'b'").get() == "ab");
+    }
+
+    SECTION("submit") {
+        auto f = pool.submit([](context &ctx) { return ctx.eval("new counter().next()").as<int>(); });
+        REQUIRE(f.get() == 1);
+    }
+
+    SECTION("errors") {
+        auto f = pool.eval<int>("throw new TypeError('nope')");
+        REQUIRE_THROWS_AS(f.get(), js_error);
+    }
+
+    SECTION("compiled scripts") {
+        auto sum = pool.compile("add(1, 2)");
+        auto scaled = pool.compile("(a, b) => add(a, b) * 2");
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 50; ++i) {
+            results.emplace_back(pool.run<int>(sum));
+            results.emplace_back(pool.run<int>(scaled, i, 1));
+        }
+        for (int i = 0; i < 50; ++i) {
+            REQUIRE(results[i * 2].get() == 3);
+            REQUIRE(results[i * 2 + 1].get() == (i + 1) * 2);
+        }
+
+        REQUIRE_THROWS_AS(pool.run<int>(pool.compile("let = ;")).get(), js_error);
+        REQUIRE_THROWS_AS(pool.run<int>(sum, 1).get(), js_error);
+        REQUIRE_THROWS_AS(pool.run<int>(runtime_pool::pooled_script()).get(), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Runtime pool compiled script lifetime", "[runtime_pool]") {
+    runtime_pool pool(1);
+    const auto functions = [&pool] {
+        return pool.submit([](context &ctx) { return ctx.memory_usage().js_func_count; }).get();
+    };
+    auto run_once = [&pool](int i) {
+        auto s = pool.compile("(function f() { return " + std::to_string(i) + "; })()");
+        return pool.run<int>(s).get();
+    };
+    REQUIRE(run_once(0) == 0);
+    const auto before = functions();
+    for (int i = 1; i <= 100; ++i) {
+        REQUIRE(run_once(i) == i);
+    }
+    // only the script from the last run can still be cached
+    REQUIRE(functions() <= before + 2);
+}
+
+TEST_CASE("Runtime pool jobs submitting jobs", "[runtime_pool]") {
+    runtime_pool pool(1);
+    auto f = pool.submit([&pool](context &) { return pool.eval<int>("20 + 22").get(); });
+    REQUIRE(f.get() == 42);
+}
+
+TEST_CASE("Runtime pool init failures", "[runtime_pool]") {
+    REQUIRE_THROWS_AS(runtime_pool(2, [](context &) { throw std::runtime_error("init failed"); }), std::runtime_error);
+
+    // one failing worker fails the whole pool, instead of taking a share of its jobs
+    std::atomic<int> inits = 0;
+    auto third_fails = [&inits](context &) {
+        if (inits++ == 2)
+            throw std::runtime_error("init failed");
+    };
+    REQUIRE_THROWS_AS(runtime_pool(4, third_fails), std::runtime_error);
+    REQUIRE(inits == 4);
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+using namespace jnjs;
+
+TEST_CASE("Compiled scripts", "[script]") {
+    runtime rt;
+    auto ctx = rt.make_context();
+
+    SECTION("run repeatedly") {
+        auto s = ctx.compile("globalThis.n = (globalThis.n ?? 0) + 1; n * 10");
+        REQUIRE(s.valid());
+        REQUIRE(s.run() == 10);
+        REQUIRE(s.run() == 20);
+        REQUIRE(s.run() == 30);
+    }
+
+    SECTION("compiling does not run") {
+        auto s = ctx.compile("globalThis.ran = true");
+        REQUIRE(ctx.eval("typeof ran").as<std::string>() == "undefined");
+        s.run();
+        REQUIRE(ctx.eval("ran").as<bool>());
+    }
+
+    SECTION("parse errors are reported at compile time") {
+        REQUIRE_THROWS_AS(ctx.compile("let = ;", "broken.js"), js_error);
+    }
+
+    SECTION("runtime errors are reported on run") {
+        auto s = ctx.compile("throw new Error('boom')");
+        auto r = s.run();
+        REQUIRE(r.is<js_error>());
+        REQUIRE(r.as<js_error>().what() == std::string("Error: boom"));
+    }
+
+    SECTION("empty script") {
+        script s;
+        REQUIRE_FALSE(s.valid());
+    }
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace jnjs;
+
+TEST_CASE("Serialization", "[serialized]") {
+    runtime rt_a;
+    runtime rt_b;
+    auto a = rt_a.make_context();
+    auto b = rt_b.make_context();
+
+    SECTION("round trip between runtimes") {
+        auto msg = a.eval("({n: 1.5, s: 'héllo', list: [1, 'two', null], nested: {ok: true}, big: 12345678901234n, "
+                          "when: new Date(0), bytes: new Uint8Array([1, 2, 3])})")
+                       .serialize();
+        REQUIRE_FALSE(msg.empty());
+        REQUIRE(msg.shared_buffers() == 0);
+
+        b.set_global("m", b.deserialize(msg));
+        REQUIRE(b.eval("m.n === 1.5 && m.s === 'héllo' && m.list[1] === 'two' && m.list[2] === null") == true);
+        REQUIRE(b.eval("m.nested.ok && m.big === 12345678901234n && m.when.getTime() === 0") == true);
+        REQUIRE(b.eval("m.bytes instanceof Uint8Array && m.bytes[2] === 3") == true);
+    }
+
+    SECTION("references are preserved") {
+        auto msg = a.eval("const shared = [1]; const o = {x: shared, y: shared}; o.self = o; o").serialize();
+        b.set_global("m", b.deserialize(msg));
+        REQUIRE(b.eval("m.x === m.y && m.self === m") == true);
+    }
+
+    SECTION("messages can be read many times") {
+        auto msg = a.eval("({n: 1})").serialize();
+        b.set_global("m1", b.deserialize(msg));
+        b.set_global("m2", b.deserialize(msg));
+        REQUIRE(b.eval("m1.n === 1 && m2.n === 1 && m1 !== m2") == true);
+    }
+
+    SECTION("empty messages") {
+        serialized msg;
+        REQUIRE(msg.empty());
+        REQUIRE(b.deserialize(msg).is<undefined>());
+        value().serialize(msg);
+        REQUIRE(msg.empty());
+    }
+
+    SECTION("unsupported values") {
+        REQUIRE_THROWS_AS(a.eval("({f() {}})").serialize(), js_error);
+        REQUIRE(a.eval("1 + 1") == 2);
+    }
+
+    SECTION("reused buffer") {
+        serialized msg;
+        a.eval("'x'.repeat(1000)").serialize(msg);
+        const auto *data = msg.data();
+        const auto size = msg.size();
+        a.eval("'y'.repeat(100)").serialize(msg);
+        REQUIRE(msg.data() == data);
+        REQUIRE(msg.size() < size);
+        REQUIRE(b.deserialize(msg) == std::string(100, 'y'));
+    }
+
+    SECTION("raw bytes") {
+        auto msg = a.eval("({list: [1, 2, 3]})").serialize(false);
+        const std::vector<uint8_t> bytes(msg.data(), msg.data() + msg.size());
+        REQUIRE(b.deserialize(bytes.data(), bytes.size())["list"].as<std::vector<int>>() == std::vector{1, 2, 3});
+
+        const std::vector<uint8_t> garbage = {0xff, 0x00, 0x12};
+        REQUIRE(b.deserialize(garbage.data(), garbage.size()).is<js_error>());
+    }
+
+    SECTION("shared array buffers") {
+        auto msg = a.eval("const sab = new SharedArrayBuffer(16); const view = new Int32Array(sab); view[0] = 1; "
+                          "({sab})")
+                       .serialize();
+        REQUIRE(msg.shared_buffers() == 1);
+
+        b.set_global("m", b.deserialize(msg));
+        REQUIRE(b.eval("new Int32Array(m.sab)[0]") == 1);
+        b.eval("new Int32Array(m.sab)[1] = 42");
+        REQUIRE(a.eval("view[1]") == 42);
+
+        REQUIRE_THROWS_AS(a.eval("({sab})").serialize(false), js_error);
+    }
+
+    SECTION("shared array buffers outlive their runtime") {
+        std::optional<serialized> msg;
+        {
+            runtime rt;
+            auto ctx = rt.make_context();
+            msg = ctx.eval("const v = new Uint8Array(new SharedArrayBuffer(4)); v[3] = 7; v.buffer").serialize();
+        }
+        b.set_global("sab", b.deserialize(*msg));
+        msg.reset();
+        REQUIRE(b.eval("new Uint8Array(sab)[3]") == 7);
+    }
+}
+
+TEST_CASE("Serialization across threads", "[serialized]") {
+    runtime_pool pool(2);
+    auto ctx = runtime::new_context();
+
+    auto msg = std::make_shared<serialized>(ctx.eval("({values: [1, 2, 3, 4]})").serialize());
+    auto count = pool.submit([msg](context &c) {
+        return c.deserialize(*msg)["values"].as<std::vector<int>>().size();
+    });
+    REQUIRE(count.get() == 4);
+
+    serialized reply;
+    auto job = pool.submit([&reply](context &c) { c.eval("({answer: 42})").serialize(reply); });
+    job.get();
+    REQUIRE(ctx.deserialize(reply)["answer"] == 42);
+}
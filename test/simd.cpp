@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/detail/simd.h>
+#include <jnjs/jnjs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace jnjs;
+namespace simd = jnjs::detail::simd;
+
+namespace {
+int sum_all(const remaining_args<int32_t> &args) { return std::accumulate(args.begin(), args.end(), 0); }
+} // namespace
+
+TEST_CASE("Numeric kernels", "[simd]") {
+    SECTION("int round trip") {
+        // odd lengths exercise every vector width and the scalar tail
+        for (size_t n = 0; n < 37; ++n) {
+            std::vector<int32_t> in(n);
+            std::iota(in.begin(), in.end(), -5);
+            std::vector<JSValue> vals(n);
+            simd::box_int32(in.data(), n, vals.data());
+            for (size_t i = 0; i < n; ++i) {
+                REQUIRE(JS_VALUE_GET_TAG(vals[i]) == JS_TAG_INT);
+                REQUIRE(JS_VALUE_GET_INT(vals[i]) == in[i]);
+            }
+            std::vector<int32_t> out(n);
+            REQUIRE(simd::unbox_int32(vals.data(), n, out.data()) == n);
+            REQUIRE(out == in);
+        }
+    }
+
+    SECTION("double round trip") {
+        for (size_t n = 0; n < 37; ++n) {
+            std::vector<double> in(n);
+            for (size_t i = 0; i < n; ++i) {
+                in[i] = static_cast<double>(i) * 0.5 - 3;
+            }
+            std::vector<JSValue> vals(n);
+            simd::box_float64(in.data(), n, vals.data());
+            for (size_t i = 0; i < n; ++i) {
+                // integral values are narrowed to ints, like value_helpers<double>::from does
+                if (i % 2 == 0) {
+                    REQUIRE(JS_VALUE_GET_TAG(vals[i]) == JS_TAG_INT);
+                    REQUIRE(JS_VALUE_GET_INT(vals[i]) == in[i]);
+                } else {
+                    REQUIRE(JS_TAG_IS_FLOAT64(JS_VALUE_GET_TAG(vals[i])));
+                    REQUIRE(JS_VALUE_GET_FLOAT64(vals[i]) == in[i]);
+                }
+            }
+            std::vector<double> out(n);
+            REQUIRE(simd::unbox_float64(vals.data(), n, out.data()) == n);
+            REQUIRE(out == in);
+        }
+    }
+
+    SECTION("doubles are boxed like value_helpers<double>::from") {
+        const double edge[] = {-0.0,
+                               0.0,
+                               0.5,
+                               -1.0,
+                               2147483647.0,
+                               -2147483648.0,
+                               2147483648.0,
+                               -2147483649.0,
+                               1e300,
+                               std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::quiet_NaN(),
+                               4294967296.0,
+                               -1.5};
+        // every rotation puts each edge case in every vector lane
+        for (size_t r = 0; r < std::size(edge); ++r) {
+            std::vector<double> in(std::begin(edge), std::end(edge));
+            std::rotate(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(r), in.end());
+            std::vector<JSValue> vals(in.size());
+            simd::box_float64(in.data(), in.size(), vals.data());
+            for (size_t i = 0; i < in.size(); ++i) {
+                const auto expected = detail::value_helpers<double>::from(nullptr, in[i]);
+                REQUIRE(JS_VALUE_GET_TAG(vals[i]) == JS_VALUE_GET_TAG(expected));
+                if (JS_VALUE_GET_TAG(expected) == JS_TAG_INT) {
+                    REQUIRE(JS_VALUE_GET_INT(vals[i]) == JS_VALUE_GET_INT(expected));
+                } else {
+                    REQUIRE(std::memcmp(&vals[i], &expected, sizeof(JSValue)) == 0);
+                }
+            }
+        }
+    }
+
+    SECTION("runs stop at the first mismatch") {
+        std::vector<JSValue> vals(19, JS_MKVAL(JS_TAG_INT, 3));
+        vals[13] = JS_NewFloat64(nullptr, 1.5);
+        std::vector<int32_t> ints(vals.size());
+        REQUIRE(simd::unbox_int32(vals.data(), vals.size(), ints.data()) == 13);
+
+        // ints widen, anything else stops the run
+        std::vector<double> doubles(vals.size());
+        vals[17] = JS_UNDEFINED;
+        REQUIRE(simd::unbox_float64(vals.data(), vals.size(), doubles.data()) == 17);
+        REQUIRE(doubles[12] == 3);
+        REQUIRE(doubles[13] == 1.5);
+    }
+
+    SECTION("function arguments") {
+        auto ctx = runtime::new_context();
+        ctx.set_global_fn<sum_all>("sum_all");
+        REQUIRE(ctx.eval("sum_all(1, 2, 3, 4, 5, 6, 7, 8, 9)") == 45);
+        // a non-int argument falls back to converting the rest one by one
+        REQUIRE(ctx.eval("sum_all(1, 2, 3, 4, 5.5, 6, 7)") == 28);
+        REQUIRE(ctx.eval("sum_all()") == 0);
+    }
+}
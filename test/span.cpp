@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+int sum(std::span<const double> v) { return static_cast<int>(std::accumulate(v.begin(), v.end(), 0.0)); }
+void fill(std::span<uint8_t> v, int b) { std::fill(v.begin(), v.end(), static_cast<uint8_t>(b)); }
+size_t byte_size(std::span<const std::byte> v) { return v.size(); }
+} // namespace
+
+TEST_CASE("Binary data", "[span]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("view typed arrays in place") {
+        auto v = ctx.eval("globalThis.f = new Float32Array([1, 2, 3, 4]); f");
+        auto s = v.as<std::span<float>>();
+        REQUIRE(s.size() == 4);
+        REQUIRE(s[2] == 3.0f);
+        s[0] = 10.0f;
+        REQUIRE(ctx.eval("f[0] === 10").as<bool>());
+    }
+
+    SECTION("subarray offsets") {
+        auto s = ctx.eval("new Int32Array([1, 2, 3, 4, 5]).subarray(1, 3)").as<std::span<const int32_t>>();
+        REQUIRE(s.size() == 2);
+        REQUIRE(s[0] == 2);
+        REQUIRE(s[1] == 3);
+    }
+
+    SECTION("array buffers") {
+        auto v = ctx.eval("new Uint8Array([7, 8, 9]).buffer");
+        REQUIRE(v.is<std::span<uint8_t>>());
+        REQUIRE_FALSE(v.is<std::span<float>>());
+        REQUIRE(v.as<std::span<uint8_t>>()[1] == 8);
+    }
+
+    SECTION("element type must match") {
+        auto v = ctx.eval("new Float64Array(2)");
+        REQUIRE(v.is<std::span<double>>());
+        REQUIRE_FALSE(v.is<std::span<float>>());
+        REQUIRE(v.is<std::span<std::byte>>());
+        REQUIRE(v.as<std::span<std::byte>>().size() == 16);
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<sum>("sum");
+        ctx.set_global_fn<fill>("fill");
+        ctx.set_global_fn<byte_size>("byte_size");
+        REQUIRE(ctx.eval("sum(new Float64Array([1.5, 2.5]))") == 4);
+        REQUIRE(ctx.eval("const b = new Uint8Array(4); fill(b, 3); b[3]") == 3);
+        REQUIRE(ctx.eval("byte_size(new Uint16Array(3))") == 6);
+        REQUIRE(ctx.eval("sum([1, 2])").is<js_error>());
+    }
+
+    SECTION("copy to js") {
+        const std::vector<int16_t> data = {1, -2, 3};
+        ctx.set_global("copied", std::span<const int16_t>(data));
+        REQUIRE(ctx.eval("copied instanceof Int16Array && copied[1] === -2").as<bool>());
+    }
+
+    SECTION("external buffers") {
+        std::vector<float> samples = {0.5f, 1.5f};
+        const auto *storage = samples.data();
+        ctx.set_global("ext", external_buffer(std::move(samples)));
+        auto view = ctx.eval("new Float32Array(ext)");
+        REQUIRE(view.as<std::span<float>>().data() == storage);
+        REQUIRE(ctx.eval("new Float32Array(ext)[1] === 1.5").as<bool>());
+    }
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace jnjs;
+
+namespace {
+size_t view_length(std::string_view s) { return s.size(); }
+size_t c_str_length(const char *s) { return std::strlen(s); }
+std::string greet(std::string_view who, std::optional<std::string_view> greeting) {
+    return std::string(greeting.value_or("hello")) + ", " + std::string(who);
+}
+std::string_view constant() { return "constant"; }
+
+struct named {
+    std::string name;
+    explicit named(std::string_view n) : name(n) {}
+    bool is(std::string_view n) { return name == n; }
+
+    constexpr static wrapped_class_builder<named> build_js_class() {
+        wrapped_class_builder<named> b("named");
+        b.bind_ctor<std::string_view>();
+        b.bind_function<&named::is>("is");
+        return b;
+    }
+};
+} // namespace
+
+TEST_CASE("Borrowed strings", "[string_ref]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("value::as") {
+        auto v = ctx.eval("'héllo wörld'");
+        auto s = v.as<string_ref>();
+        REQUIRE(s.valid());
+        REQUIRE(s.view() == "héllo wörld");
+        REQUIRE(std::string_view(s).size() == std::strlen("héllo wörld"));
+        REQUIRE(ctx.eval("42").as<string_ref>().view() == "42");
+    }
+
+    SECTION("embedded nulls") {
+        auto s = ctx.eval("'a\\0b'").as<string_ref>();
+        REQUIRE(s.size() == 3);
+        REQUIRE(s.view() == std::string_view("a\0b", 3));
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<view_length>("view_length");
+        ctx.set_global_fn<c_str_length>("c_str_length");
+        ctx.set_global_fn<greet>("greet");
+        ctx.set_global_fn<constant>("constant");
+        REQUIRE(ctx.eval("view_length('abcdef')") == 6);
+        REQUIRE(ctx.eval("c_str_length('abc')") == 3);
+        REQUIRE(ctx.eval("view_length(12345)") == 5);
+        REQUIRE(ctx.eval("greet('world')").as<std::string>() == "hello, world");
+        REQUIRE(ctx.eval("greet('world', 'hi')").as<std::string>() == "hi, world");
+        REQUIRE(ctx.eval("constant()").as<std::string>() == "constant");
+        REQUIRE(ctx.eval("view_length(Symbol())").is<js_error>());
+        REQUIRE(ctx.eval("view_length({ toString() { throw new Error('nope'); } })").is<js_error>());
+    }
+
+    SECTION("class methods and constructors") {
+        ctx.install_class<named>();
+        REQUIRE(ctx.eval("new named('x').is('x')").as<bool>());
+        REQUIRE_FALSE(ctx.eval("new named('x').is('y')").as<bool>());
+    }
+}
+
+TEST_CASE("String marshalling", "[string]") {
+    auto ctx = runtime::new_context();
+    auto echo = ctx.eval("(s) => s").as<function>();
+    auto length = ctx.eval("(s) => s.length").as<function>();
+
+    SECTION("embedded nulls") {
+        const std::string s("a\0b", 3);
+        REQUIRE(length(s) == 3);
+        REQUIRE(echo(s).as<std::string>() == s);
+    }
+
+    SECTION("utf-16") {
+        const std::u16string s = u"hé€\U0001F600";
+        REQUIRE(length(s) == 5);
+        REQUIRE(echo(s).as<std::u16string>() == s);
+        REQUIRE(echo(std::u16string_view(s)).as<std::string>() == "hé€\U0001F600");
+    }
+
+    SECTION("latin-1") {
+        REQUIRE(echo(latin1_view{"plain"}).as<std::string>() == "plain");
+        // "café" in ISO-8859-1
+        REQUIRE(echo(latin1_view{"caf\xe9"}).as<std::string>() == "café");
+        REQUIRE(length(latin1_view{"caf\xe9"}) == 4);
+
+        // every byte value, with ASCII prefixes that end on and off the 8 byte stride
+        std::string all;
+        std::u16string expected;
+        for (int b = 0; b < 256; ++b) {
+            all += static_cast<char>(b);
+            expected += static_cast<char16_t>(b);
+        }
+        for (const size_t prefix : {0, 7, 8, 13, 16}) {
+            const auto s = std::string(prefix, 'a') + all;
+            REQUIRE(echo(latin1_view{s}).as<std::u16string>() == std::u16string(prefix, u'a') + expected);
+        }
+    }
+
+    SECTION("numbers") {
+        REQUIRE(ctx.eval("42").as<std::string>() == "42");
+        REQUIRE(ctx.eval("-7").as<std::string>() == "-7");
+        REQUIRE(ctx.eval("2 ** 40").as<std::string>() == "1099511627776");
+        REQUIRE(ctx.eval("-0").as<std::string>() == "0");
+        REQUIRE(ctx.eval("1.5").as<std::string>() == "1.5");
+        REQUIRE(ctx.eval("1e21").as<std::string>() == "1e+21");
+        REQUIRE(ctx.eval("NaN").as<std::string>() == "NaN");
+    }
+}
@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <string>
+
+using namespace jnjs;
+
+TEST_CASE("Value scopes", "[value_scope]") {
+    auto ctx = runtime::new_context();
+    auto root = ctx.eval("({ items: [{ price: 2 }, { price: 3 }, { price: 5 }], name: 'cart' })");
+
+    SECTION("walking data") {
+        value_scope scope(ctx);
+        auto items = scope.get(root, key<"items">);
+        const auto len = scope.get(items, "length").as<int>();
+        int total = 0;
+        for (int i = 0; i < len; ++i) {
+            total += scope.get(scope.get(items, i), key<"price">).as<int>();
+        }
+        REQUIRE(total == 10);
+        REQUIRE(scope.size() == 8);
+        REQUIRE(scope.get(root, "name").as<std::string>() == "cart");
+        REQUIRE(scope.get(root, "missing").is<undefined>());
+    }
+
+    SECTION("clearing") {
+        value_scope scope(ctx, 4);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(scope.get(scope.get(root, key<"items">), 0)["price"] == 2);
+            scope.clear();
+        }
+        REQUIRE(scope.size() == 0);
+    }
+
+    SECTION("made and adopted values") {
+        value kept;
+        {
+            value_scope scope(ctx);
+            auto s = scope.make(std::string("abc"));
+            REQUIRE(s["length"] == 3);
+            auto v = ctx.eval("[1, 2]");
+            auto a = scope.adopt(std::move(v));
+            REQUIRE(v.is<undefined>());
+            REQUIRE(a["length"] == 2);
+            kept = a.to_value();
+        }
+        REQUIRE(kept[1] == 2);
+    }
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace jnjs;
+
+namespace {
+int sum(const std::vector<int> &v) { return std::accumulate(v.begin(), v.end(), 0); }
+typed_array<int32_t> iota(int n) {
+    typed_array<int32_t> ret(n);
+    std::iota(ret.begin(), ret.end(), 0);
+    return ret;
+}
+} // namespace
+
+TEST_CASE("Vector conversion", "[vector]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("from js arrays") {
+        REQUIRE(ctx.eval("[1, 2, 3]").as<std::vector<int>>() == std::vector<int>{1, 2, 3});
+        REQUIRE(ctx.eval("['a', 'b']").as<std::vector<std::string>>() == std::vector<std::string>{"a", "b"});
+        REQUIRE(ctx.eval("[]").as<std::vector<int>>().empty());
+        // holes read as undefined
+        REQUIRE(ctx.eval("[1, , 3]").as<std::vector<std::optional<int>>>()[1] == std::nullopt);
+    }
+
+    SECTION("to js arrays") {
+        auto echo = ctx.eval("(a) => Array.isArray(a) ? a.join(',') : 'no'").as<function>();
+        REQUIRE(echo(std::vector<int>{4, 5, 6}).as<std::string>() == "4,5,6");
+        REQUIRE(echo(std::vector<std::string>{"x", "y"}).as<std::string>() == "x,y");
+        REQUIRE(echo(std::vector<int>{}).as<std::string>().empty());
+    }
+
+    SECTION("large arrays") {
+        std::vector<int> big(100000);
+        std::iota(big.begin(), big.end(), 0);
+        ctx.set_global("big", big);
+        REQUIRE(ctx.eval("big.length === 100000 && big[99999] === 99999").as<bool>());
+        REQUIRE(ctx.eval("big").as<std::vector<int>>() == big);
+    }
+
+    SECTION("typed arrays") {
+        REQUIRE(ctx.eval("new Int32Array([7, 8])").as<std::vector<int>>() == std::vector<int>{7, 8});
+        REQUIRE_FALSE(ctx.eval("new Float32Array(1)").is_convertible<std::vector<int>>());
+
+        ctx.set_global_fn<iota>("iota");
+        REQUIRE(ctx.eval("const t = iota(5); t instanceof Int32Array && t[4] === 4").as<bool>());
+        REQUIRE(ctx.eval("iota(3)").as<typed_array<int32_t>>() == typed_array<int32_t>{0, 1, 2});
+        REQUIRE(ctx.eval("[1, 2]").as<typed_array<int32_t>>() == typed_array<int32_t>{1, 2});
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<sum>("sum");
+        REQUIRE(ctx.eval("sum([1, 2, 3, 4])") == 10);
+        REQUIRE(ctx.eval("sum(new Int32Array([5, 5]))") == 10);
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <jnjs/jnjs.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jnjs;
+
+static_assert(std::random_access_iterator<array_view<int>::iterator>);
+static_assert(std::forward_iterator<object_view<int>::iterator>);
+
+namespace {
+// A number whose conversion throws on anything else.
+struct strict_number {
+    double v;
+};
+} // namespace
+
+template <> struct jnjs::detail::value_helpers<strict_number> {
+    static bool is(JSContext *, const JSValue v) { return JS_IsNumber(v); }
+    static bool is_convertible(JSContext *c, const JSValue v) { return is(c, v); }
+    static strict_number as(JSContext *c, const JSValue v) {
+        if (!is(c, v))
+            throw std::invalid_argument("not a number");
+        return {value_helpers<double>::as(c, v)};
+    }
+    static JSValue from(JSContext *c, const strict_number &n) { return value_helpers<double>::from(c, n.v); }
+};
+
+namespace {
+int second(const array_view<int> &a) { return a.size() > 1 ? a[1] : -1; }
+int role(object_view<int> o) { return o.find("role").value_or(-1); }
+} // namespace
+
+TEST_CASE("Lazy views", "[views]") {
+    auto ctx = runtime::new_context();
+
+    SECTION("array_view") {
+        ctx.eval("var reads = 0; var arr = [3, 1, 2];"
+                 "for (let i = 0; i < 3; ++i) { const v = arr[i]; Object.defineProperty(arr, i, { get() { ++reads; "
+                 "return v; } }); }");
+        auto a = ctx.get_global("arr").as<array_view<int>>();
+        REQUIRE(a.size() == 3);
+        REQUIRE(ctx.eval("reads") == 0);
+        REQUIRE(a[2] == 2);
+        REQUIRE(ctx.eval("reads") == 1);
+        REQUIRE_THROWS_AS(a.at(3), std::out_of_range);
+
+        std::vector<int> copy(a.begin(), a.end());
+        REQUIRE(copy == std::vector<int>{3, 1, 2});
+        REQUIRE(*std::max_element(a.begin(), a.end()) == 3);
+        REQUIRE(a.end() - a.begin() == 3);
+
+        auto t = ctx.eval("new Float64Array([0.5, 1.5])").as<array_view<double>>();
+        REQUIRE(t.size() == 2);
+        REQUIRE(t[1] == 1.5);
+        REQUIRE(ctx.eval("1").as<array_view<int>>().empty());
+    }
+
+    SECTION("object_view") {
+        auto o = ctx.eval("({ a: 1, b: 2, u: undefined })").as<object_view<int>>();
+        REQUIRE(o.find("a") == 1);
+        REQUIRE(o.find(key<"b">) == 2);
+        REQUIRE(o.find("u") == std::nullopt);
+        REQUIRE(o.find("missing") == std::nullopt);
+        REQUIRE(o.at("a") == 1);
+        REQUIRE_THROWS_AS(o.at("c"), std::out_of_range);
+        REQUIRE(o.contains(key<"b">));
+
+        REQUIRE(o.size() == 3);
+        std::vector<std::string> keys;
+        for (const auto &[k, v] : o) {
+            keys.push_back(k);
+        }
+        REQUIRE(keys == std::vector<std::string>{"a", "b", "u"});
+        REQUIRE(o.to_value()["b"] == 2);
+    }
+
+    SECTION("throwing getters") {
+        auto o = ctx.eval("({ get bad() { throw new RangeError('nope'); }, ok: 1 })").as<object_view<int>>();
+        REQUIRE_THROWS_AS(o.find("bad"), js_error);
+        REQUIRE_THROWS_AS(o.at(key<"bad">), js_error);
+        using entries = std::vector<std::pair<std::string, int>>;
+        REQUIRE_THROWS_AS(entries(o.begin(), o.end()), js_error);
+        auto a = ctx.eval("Object.defineProperty([1, 2], 1, { get() { throw new RangeError('nope'); } })")
+                     .as<array_view<int>>();
+        REQUIRE(a.size() == 2);
+        REQUIRE(a[0] == 1);
+        REQUIRE_THROWS_AS(a[1], js_error);
+        REQUIRE_THROWS_AS(std::vector<int>(a.begin(), a.end()), js_error);
+        // nothing is left pending
+        REQUIRE(o.find("ok") == 1);
+        REQUIRE(ctx.eval("1 + 1") == 2);
+    }
+
+    SECTION("failed conversions free the element") {
+        const auto before = ctx.memory_usage().obj_count;
+        {
+            auto a = ctx.eval("[1, {}, [2]]").as<array_view<strict_number>>();
+            REQUIRE(a[0].v == 1);
+            REQUIRE_THROWS_AS(a[1], std::invalid_argument);
+            REQUIRE_THROWS_AS(a[2], std::invalid_argument);
+            auto o = ctx.eval("({ a: {} })").as<object_view<strict_number>>();
+            REQUIRE_THROWS_AS(o.find("a"), std::invalid_argument);
+        }
+        REQUIRE(ctx.memory_usage().obj_count == before);
+    }
+
+    SECTION("function arguments") {
+        ctx.set_global_fn<second>("second");
+        ctx.set_global_fn<role>("role");
+        REQUIRE(ctx.eval("second([5, 6, 7])") == 6);
+        REQUIRE(ctx.eval("second([5])") == -1);
+        REQUIRE(ctx.eval("role({ name: 'x', role: 4 })") == 4);
+        REQUIRE(ctx.eval("role({})") == -1);
+    }
+}